@@ -1,7 +1,30 @@
 #include "options/american_option.h"
+#include "options/bermudan_option.h"
 #include "options/european_option.h"
+#include "pricing/analytic_american.h"
 #include "pricing/binomial_tree.h"
 #include "pricing/black_scholes.h"
+#include "pricing/chebyshev_proxy.h"
+#include "pricing/heston.h"
+#include "pricing/implied_vol.h"
+#include "pricing/mixed_precision.h"
+#include "pricing/numa_book.h"
+#include "pricing/scenario_engine.h"
+#include "service/book_snapshot.h"
+#include "service/portfolio_risk.h"
+#include "service/pricing_service.h"
+#include "service/quote_pipeline.h"
+#include "service/risk_runner.h"
+#include "utils/numa.h"
+#include "utils/parallel.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
 #include <benchmark/benchmark.h>
 
 static void BM_BlackScholesPrice_Call(benchmark::State &state) {
@@ -104,4 +127,978 @@ static void BM_BinomialTreePrice(benchmark::State &state) {
 }
 BENCHMARK(BM_BinomialTreePrice)->RangeMultiplier(2)->Range(16, 8192);
 
+static void BM_BinomialTreePrice_European(benchmark::State &state) {
+  const EuropeanOption option(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  const int &numSteps = state.range(0);
+  for (auto _ : state) {
+    double price = BinomialTree::price(option, numSteps);
+    benchmark::DoNotOptimize(price);
+  }
+}
+BENCHMARK(BM_BinomialTreePrice_European)->RangeMultiplier(2)->Range(16, 8192);
+
+static void BM_BinomialTreePrice_Bermudan(benchmark::State &state) {
+  const BermudanOption option(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put,
+                              {0.25, 0.5, 0.75});
+  const int &numSteps = state.range(0);
+  for (auto _ : state) {
+    double price = BinomialTree::price(option, numSteps);
+    benchmark::DoNotOptimize(price);
+  }
+}
+BENCHMARK(BM_BinomialTreePrice_Bermudan)->RangeMultiplier(2)->Range(16, 8192);
+
+static void BM_BinomialTreePrice_TermStructure(benchmark::State &state) {
+  const AmericanOption option(100.0, 100.0, 0.0, 1.0, 0.2, OptionType::Put);
+  const YieldCurve curve({0.25, 0.5, 1.0, 2.0}, {0.03, 0.035, 0.04, 0.042});
+  const DividendSchedule dividends({{0.25, 1.0}, {0.75, 1.0}});
+  const int &numSteps = state.range(0);
+  for (auto _ : state) {
+    double price = BinomialTree::price(option, numSteps, curve, dividends);
+    benchmark::DoNotOptimize(price);
+  }
+}
+BENCHMARK(BM_BinomialTreePrice_TermStructure)
+    ->RangeMultiplier(2)
+    ->Range(16, 8192);
+
+static std::vector<EuropeanOption> makeEuropeanBook(const size_t &size) {
+  std::vector<EuropeanOption> book;
+  book.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    const double strike = 70.0 + 60.0 * static_cast<double>(i) / size;
+    const double sigma = 0.1 + 0.05 * static_cast<double>(i % 8);
+    book.emplace_back(100.0, strike, 0.03, 0.5 + 0.25 * (i % 4), sigma,
+                      i % 2 == 0 ? OptionType::Call : OptionType::Put, 0.01);
+  }
+  return book;
+}
+
+// Batch pricing in Real; max_abs_err is measured against the double
+// per-contract path.
+template <typename Real>
+static void BM_BlackScholesPriceBatch(benchmark::State &state) {
+  const std::vector<EuropeanOption> book = makeEuropeanBook(state.range(0));
+  std::vector<BasicEuropeanOption<Real>> options;
+  for (const EuropeanOption &option : book) {
+    options.emplace_back(option.getSpotPrice(), option.getStrikePrice(),
+                         option.getRiskFreeRate(), option.getMaturity(),
+                         option.getVolatility(), option.getType(),
+                         option.getDividendYield());
+  }
+  std::vector<Real> prices(options.size());
+  for (auto _ : state) {
+    BlackScholes::priceBatch(options, prices.data());
+    benchmark::DoNotOptimize(prices.data());
+    benchmark::ClobberMemory();
+  }
+
+  double maxError = 0.0;
+  for (size_t i = 0; i < book.size(); ++i) {
+    maxError = std::max(maxError, std::abs(static_cast<double>(prices[i]) -
+                                           BlackScholes::price(book[i])));
+  }
+  state.counters["max_abs_err"] = maxError;
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_BlackScholesPriceBatch, float)->Range(64, 16384);
+BENCHMARK_TEMPLATE(BM_BlackScholesPriceBatch, double)->Range(64, 16384);
+
+// Price and five Greeks of a book: one shared d1/d2 per contract against the
+// six per-Greek functions.
+static void BM_BlackScholesGreeksBatch(benchmark::State &state) {
+  const std::vector<EuropeanOption> book = makeEuropeanBook(state.range(0));
+  std::vector<Greeks> greeks(book.size());
+  for (auto _ : state) {
+    BlackScholes::greeksBatch(book, greeks.data());
+    benchmark::DoNotOptimize(greeks.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BlackScholesGreeksBatch)->Range(64, 16384);
+
+static void BM_BlackScholesGreeksScalar(benchmark::State &state) {
+  const std::vector<EuropeanOption> book = makeEuropeanBook(state.range(0));
+  std::vector<Greeks> greeks(book.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < book.size(); ++i) {
+      const EuropeanOption &option = book[i];
+      greeks[i] = {BlackScholes::price(option), BlackScholes::delta(option),
+                   BlackScholes::gamma(option), BlackScholes::vega(option),
+                   BlackScholes::theta(option), BlackScholes::rho(option)};
+    }
+    benchmark::DoNotOptimize(greeks.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BlackScholesGreeksScalar)->Range(64, 16384);
+
+// Implied vols of a strip from a 0.2 cold start: the batch solver against
+// calculateImpliedVolatility per quote.
+static void BM_EuropeanImpliedVolBatch(benchmark::State &state) {
+  std::vector<EuropeanOption> strip = makeEuropeanBook(state.range(0));
+  std::vector<double> quotes;
+  for (EuropeanOption &option : strip) {
+    quotes.push_back(BlackScholes::price(option));
+    option.setVolatilityImpl(0.2);
+  }
+  std::vector<double> vols(strip.size());
+  for (auto _ : state) {
+    ImpliedVolatility::impliedVolatilityBatch(strip, quotes, vols.data());
+    benchmark::DoNotOptimize(vols.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EuropeanImpliedVolBatch)->Range(64, 4096);
+
+static void BM_EuropeanImpliedVolScalar(benchmark::State &state) {
+  const std::vector<EuropeanOption> strip = makeEuropeanBook(state.range(0));
+  std::vector<double> quotes;
+  for (const EuropeanOption &option : strip) {
+    quotes.push_back(BlackScholes::price(option));
+  }
+  std::vector<double> vols(strip.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < strip.size(); ++i) {
+      vols[i] = ImpliedVolatility::calculateImpliedVolatility(
+          strip[i], quotes[i], 1e-9, 100, 0.2);
+    }
+    benchmark::DoNotOptimize(vols.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EuropeanImpliedVolScalar)->Range(64, 4096);
+
+template <typename Real>
+static void BM_BinomialTreePrice_Precision(benchmark::State &state) {
+  const AmericanOption reference(100.0, 100.0, 0.05, 1.0, 0.2,
+                                 OptionType::Put);
+  const BasicAmericanOption<Real> option(100, 100, Real(0.05), 1, Real(0.2),
+                                         OptionType::Put);
+  const int &numSteps = state.range(0);
+  Real price = 0;
+  for (auto _ : state) {
+    price = BinomialTree::price(option, numSteps);
+    benchmark::DoNotOptimize(price);
+  }
+  state.counters["abs_err"] =
+      std::abs(price - BinomialTree::price(reference, numSteps));
+}
+BENCHMARK_TEMPLATE(BM_BinomialTreePrice_Precision, float)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096);
+BENCHMARK_TEMPLATE(BM_BinomialTreePrice_Precision, double)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096);
+
+static void BM_MixedPrecisionScreen(benchmark::State &state) {
+  const std::vector<EuropeanOption> book = makeEuropeanBook(state.range(0));
+  // re-price the contracts close to a 5.0 decision threshold
+  const MixedPrecision::Flag nearThreshold = [](const size_t &,
+                                                const float &price) {
+    return std::abs(price - 5.0f) < 0.5f;
+  };
+  for (auto _ : state) {
+    ScreeningResult result = MixedPrecision::screen(book, nearThreshold);
+    benchmark::DoNotOptimize(result.prices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MixedPrecisionScreen)->Range(64, 16384);
+
+static ShockGrid makeRiskGrid() {
+  // 21 x 11 x 5 spot x vol x rate grid of the overnight risk run
+  ShockGrid grid;
+  for (int i = -10; i <= 10; ++i) {
+    grid.spotShocks.push_back(0.02 * i);
+  }
+  for (int i = -5; i <= 5; ++i) {
+    grid.volShocks.push_back(0.01 * i);
+  }
+  for (int i = -2; i <= 2; ++i) {
+    grid.rateShocks.push_back(0.0025 * i);
+  }
+  return grid;
+}
+
+static void BM_ScenarioEngine_European(benchmark::State &state) {
+  const std::vector<EuropeanOption> book = makeEuropeanBook(state.range(0));
+  const ShockGrid grid = makeRiskGrid();
+  for (auto _ : state) {
+    PnlCube cube = ScenarioEngine::run(book, grid);
+    benchmark::DoNotOptimize(cube.values().data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 21 * 11 * 5);
+}
+BENCHMARK(BM_ScenarioEngine_European)->Range(16, 1024);
+
+// Baseline: a fresh EuropeanOption and BlackScholes::price per scenario
+static void BM_ScenarioRepricing_European(benchmark::State &state) {
+  const std::vector<EuropeanOption> book = makeEuropeanBook(state.range(0));
+  const ShockGrid grid = makeRiskGrid();
+  std::vector<double> pnl;
+  for (auto _ : state) {
+    pnl.clear();
+    for (const EuropeanOption &option : book) {
+      const double base = BlackScholes::price(option);
+      for (const double &dr : grid.rateShocks) {
+        for (const double &dv : grid.volShocks) {
+          for (const double &ds : grid.spotShocks) {
+            const EuropeanOption shocked(
+                option.getSpotPrice() * (1.0 + ds), option.getStrikePrice(),
+                option.getRiskFreeRate() + dr, option.getMaturity(),
+                option.getVolatility() + dv, option.getType(),
+                option.getDividendYield());
+            pnl.push_back(BlackScholes::price(shocked) - base);
+          }
+        }
+      }
+    }
+    benchmark::DoNotOptimize(pnl.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 21 * 11 * 5);
+}
+BENCHMARK(BM_ScenarioRepricing_European)->Range(16, 1024);
+
+static std::vector<AmericanOption> makeAmericanBook(const size_t &size) {
+  std::vector<AmericanOption> book;
+  for (const EuropeanOption &option : makeEuropeanBook(size)) {
+    // a dividend yield above the rate so calls exercise early too
+    book.emplace_back(option.getSpotPrice(), option.getStrikePrice(),
+                      option.getRiskFreeRate(), option.getMaturity(),
+                      option.getVolatility(), option.getType(), 0.05);
+  }
+  return book;
+}
+
+// float lanes over an American book, double lanes for the flagged contracts
+static void BM_MixedPrecisionScreen_American(benchmark::State &state) {
+  const std::vector<AmericanOption> book = makeAmericanBook(state.range(0));
+  const MixedPrecision::Flag nearThreshold = [](const size_t &,
+                                                const float &price) {
+    return std::abs(price - 5.0f) < 0.5f;
+  };
+  for (auto _ : state) {
+    ScreeningResult result = MixedPrecision::screen(book, 200, nearThreshold);
+    benchmark::DoNotOptimize(result.prices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MixedPrecisionScreen_American)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+// American books under the same grid on a 100-step lattice; items are
+// scenarios.
+static void BM_ScenarioEngine_American(benchmark::State &state) {
+  const std::vector<AmericanOption> book = makeAmericanBook(state.range(0));
+  const ShockGrid grid = makeRiskGrid();
+  for (auto _ : state) {
+    PnlCube cube = ScenarioEngine::run(book, grid, 100, 1);
+    benchmark::DoNotOptimize(cube.values().data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 21 * 11 * 5);
+}
+BENCHMARK(BM_ScenarioEngine_American)->Arg(4)->Unit(benchmark::kMillisecond);
+
+// Baseline: BinomialTree::price per scenario
+static void BM_ScenarioRepricing_American(benchmark::State &state) {
+  const std::vector<AmericanOption> book = makeAmericanBook(state.range(0));
+  const ShockGrid grid = makeRiskGrid();
+  std::vector<double> pnl;
+  for (auto _ : state) {
+    pnl.clear();
+    for (const AmericanOption &option : book) {
+      const double base = BinomialTree::price(option, 100);
+      for (const double &dr : grid.rateShocks) {
+        for (const double &dv : grid.volShocks) {
+          for (const double &ds : grid.spotShocks) {
+            const AmericanOption shocked(
+                option.getSpotPrice() * (1.0 + ds), option.getStrikePrice(),
+                option.getRiskFreeRate() + dr, option.getMaturity(),
+                option.getVolatility() + dv, option.getType(),
+                option.getDividendYield());
+            pnl.push_back(BinomialTree::price(shocked, 100) - base);
+          }
+        }
+      }
+    }
+    benchmark::DoNotOptimize(pnl.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 21 * 11 * 5);
+}
+BENCHMARK(BM_ScenarioRepricing_American)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond);
+
+// 4096-step tree prices of makeAmericanBook(64), the accuracy reference for
+// the analytic approximations. The tree's own ~1e-3 error floors the figures
+// of the exercise boundary method.
+static const std::vector<double> &americanReference() {
+  static const std::vector<double> reference = [] {
+    std::vector<double> prices;
+    for (const AmericanOption &option : makeAmericanBook(64)) {
+      prices.push_back(BinomialTree::price(option, 4096));
+    }
+    return prices;
+  }();
+  return reference;
+}
+
+static void reportAmericanError(benchmark::State &state,
+                                const std::vector<double> &prices) {
+  const std::vector<double> &reference = americanReference();
+  double maxError = 0.0;
+  double sumError = 0.0;
+  for (size_t i = 0; i < prices.size(); ++i) {
+    maxError = std::max(maxError, std::abs(prices[i] - reference[i]));
+    sumError += std::abs(prices[i] - reference[i]);
+  }
+  state.counters["max_abs_err"] = maxError;
+  state.counters["mean_abs_err"] = sumError / prices.size();
+  state.SetItemsProcessed(state.iterations() * prices.size());
+}
+
+static void BM_AnalyticAmerican(benchmark::State &state,
+                                const AmericanApproximation method) {
+  const std::vector<AmericanOption> book = makeAmericanBook(64);
+  std::vector<double> prices(book.size());
+  for (auto _ : state) {
+    AnalyticAmerican::priceBatch(book, prices.data(), method);
+    benchmark::DoNotOptimize(prices.data());
+  }
+  reportAmericanError(state, prices);
+}
+BENCHMARK_CAPTURE(BM_AnalyticAmerican, BaroneAdesiWhaley,
+                  AmericanApproximation::BaroneAdesiWhaley);
+BENCHMARK_CAPTURE(BM_AnalyticAmerican, BjerksundStensland,
+                  AmericanApproximation::BjerksundStensland);
+BENCHMARK_CAPTURE(BM_AnalyticAmerican, ExerciseBoundary,
+                  AmericanApproximation::ExerciseBoundary);
+
+// accuracy/latency trade-off of the fixed-point iteration count
+static void BM_ExerciseBoundaryIterations(benchmark::State &state) {
+  const std::vector<AmericanOption> book = makeAmericanBook(64);
+  ExerciseBoundaryConfig config;
+  config.iterations = state.range(0);
+  std::vector<double> prices(book.size());
+  for (auto _ : state) {
+    AnalyticAmerican::priceBatch(book, prices.data(),
+                                 AmericanApproximation::ExerciseBoundary,
+                                 config);
+    benchmark::DoNotOptimize(prices.data());
+  }
+  reportAmericanError(state, prices);
+}
+BENCHMARK(BM_ExerciseBoundaryIterations)->DenseRange(0, 8, 2);
+
+// the lattice on the same book, for latency at equal accuracy
+static void BM_AmericanBookTree(benchmark::State &state) {
+  const std::vector<AmericanOption> book = makeAmericanBook(64);
+  const int &numSteps = state.range(0);
+  std::vector<double> prices(book.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < book.size(); ++i) {
+      prices[i] = BinomialTree::price(book[i], numSteps);
+    }
+    benchmark::DoNotOptimize(prices.data());
+  }
+  reportAmericanError(state, prices);
+}
+BENCHMARK(BM_AmericanBookTree)->RangeMultiplier(4)->Range(64, 1024);
+
+static ProxyConfig makeProxyConfig() {
+  ProxyConfig config;
+  config.box = {0.8, 1.2, 0.15, 0.35, 0.25, 1.0};
+  return config;
+}
+
+// Tabulation of one bucket; the argument is the thread count.
+static void BM_ChebyshevProxyBuild(benchmark::State &state) {
+  for (auto _ : state) {
+    ChebyshevProxy proxy = ChebyshevProxy::build(
+        makeProxyConfig(), {{0.03, 0.0, OptionType::Put}}, state.range(0));
+    benchmark::DoNotOptimize(proxy);
+  }
+}
+BENCHMARK(BM_ChebyshevProxyBuild)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Query latency inside the box; compare with BM_BinomialTreePrice/512.
+static void BM_ChebyshevProxyPrice(benchmark::State &state) {
+  const ChebyshevProxy proxy =
+      ChebyshevProxy::build(makeProxyConfig(), {{0.03, 0.0, OptionType::Put}});
+  std::vector<AmericanOption> queries;
+  for (int i = 0; i < 64; ++i) {
+    queries.emplace_back(82.0 + 0.5 * i, 100.0, 0.03, 0.3 + 0.01 * i,
+                         0.16 + 0.003 * i, OptionType::Put);
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(proxy.price(queries[i++ % queries.size()]));
+  }
+
+  const int &numSteps = proxy.config().numSteps;
+  double maxError = 0.0;
+  for (const AmericanOption &option : queries) {
+    maxError = std::max(maxError, std::abs(proxy.price(option) -
+                                           BinomialTree::price(option,
+                                                               numSteps)));
+  }
+  state.counters["max_abs_err"] = maxError;
+  state.counters["est_err"] = 100.0 * proxy.errorEstimate(0).price;
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ChebyshevProxyPrice);
+
+static std::vector<EuropeanOption> makeStrikeStrip(const size_t &size) {
+  std::vector<EuropeanOption> strip;
+  for (size_t i = 0; i < size; ++i) {
+    strip.emplace_back(100.0, 50.0 + 100.0 * static_cast<double>(i) / size,
+                       0.03, 1.0, 0.2, OptionType::Put, 0.01);
+  }
+  return strip;
+}
+
+static const HestonParameters kBenchmarkHeston{0.04, 1.5, 0.05, 0.5, -0.7};
+
+// One transform per strip; items are strikes.
+static void BM_HestonStrip(benchmark::State &state, const StripMethod method) {
+  const std::vector<EuropeanOption> strip = makeStrikeStrip(state.range(0));
+  std::vector<double> prices(strip.size());
+  for (auto _ : state) {
+    Heston::priceStrip(strip, kBenchmarkHeston, prices.data(), method);
+    benchmark::DoNotOptimize(prices.data());
+  }
+  double maxError = 0.0;
+  for (size_t i = 0; i < strip.size(); i += 8) {
+    const double reference = Heston::price(strip[i], kBenchmarkHeston);
+    maxError = std::max(maxError, std::abs(prices[i] - reference));
+  }
+  state.counters["max_abs_err"] = maxError;
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_HestonStrip, Cos, StripMethod::Cos)->Range(8, 1024);
+BENCHMARK_CAPTURE(BM_HestonStrip, CarrMadan, StripMethod::CarrMadan)
+    ->Range(8, 1024);
+
+// Per-strike numerical integration, the baseline for the strip methods.
+static void BM_HestonPerStrike(benchmark::State &state) {
+  const std::vector<EuropeanOption> strip = makeStrikeStrip(state.range(0));
+  std::vector<double> prices(strip.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < strip.size(); ++i) {
+      prices[i] = Heston::price(strip[i], kBenchmarkHeston);
+    }
+    benchmark::DoNotOptimize(prices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HestonPerStrike)->Range(8, 1024);
+
+template <typename Real>
+static std::vector<BasicAmericanOption<Real>> makeAmericanBookOf(
+    const size_t &size) {
+  std::vector<BasicAmericanOption<Real>> book;
+  for (const AmericanOption &option : makeAmericanBook(size)) {
+    book.emplace_back(option.getSpotPrice(), option.getStrikePrice(),
+                      option.getRiskFreeRate(), option.getMaturity(),
+                      option.getVolatility(), option.getType(),
+                      option.getDividendYield());
+  }
+  return book;
+}
+
+// A 256-option American book through the lane-batched tree on one thread;
+// items are options. Compare with BM_BinomialTreeBookScalar at equal N. In
+// float both paths slow down at large N once the values near the zero
+// boundary decay into subnormals.
+template <typename Real>
+static void BM_BinomialTreeBatch(benchmark::State &state) {
+  const std::vector<BasicAmericanOption<Real>> book =
+      makeAmericanBookOf<Real>(256);
+  const int &numSteps = state.range(0);
+  std::vector<Real> prices(book.size());
+  for (auto _ : state) {
+    BinomialTree::priceBatch(book, numSteps, prices.data());
+    benchmark::DoNotOptimize(prices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * book.size());
+}
+BENCHMARK_TEMPLATE(BM_BinomialTreeBatch, float)
+    ->Arg(50)->Arg(100)->Arg(200)->Arg(400)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_BinomialTreeBatch, double)
+    ->Arg(50)->Arg(100)->Arg(200)->Arg(400)->Arg(1000);
+
+template <typename Real>
+static void BM_BinomialTreeBookScalar(benchmark::State &state) {
+  const std::vector<BasicAmericanOption<Real>> book =
+      makeAmericanBookOf<Real>(256);
+  const int &numSteps = state.range(0);
+  std::vector<Real> prices(book.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < book.size(); ++i) {
+      prices[i] = BinomialTree::price(book[i], numSteps);
+    }
+    benchmark::DoNotOptimize(prices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * book.size());
+}
+BENCHMARK_TEMPLATE(BM_BinomialTreeBookScalar, float)
+    ->Arg(50)->Arg(100)->Arg(200)->Arg(400)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_BinomialTreeBookScalar, double)
+    ->Arg(50)->Arg(100)->Arg(200)->Arg(400)->Arg(1000);
+
+// Strong scaling of one large tree (args: steps, threads); threads = 0 is
+// the serial engine, the baseline for the speedup.
+static void BM_BinomialTreeWavefront(benchmark::State &state) {
+  const AmericanOption option(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  const int &numSteps = state.range(0);
+  const unsigned threads = static_cast<unsigned>(state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        threads == 0 ? BinomialTree::price(option, numSteps)
+                     : BinomialTree::priceParallel(option, numSteps, threads));
+  }
+  state.SetItemsProcessed(state.iterations() * (numSteps + 1) *
+                          (numSteps + 2) / 2);
+}
+BENCHMARK(BM_BinomialTreeWavefront)
+    ->ArgsProduct({{10000, 30000, 100000}, {0, 1, 2, 4, 8, 16}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// A 64-quote American chain (calls and puts, strikes 70-125) and its
+// 500-step tree prices, the quotes of the implied volatility benchmarks.
+static std::vector<AmericanOption>
+makeAmericanChain(std::vector<double> &quotes) {
+  std::vector<AmericanOption> chain;
+  for (int i = 0; i < 64; ++i) {
+    AmericanOption option(100.0, 70.0 + 55.0 * (i / 2) / 31.0, 0.04, 0.75,
+                          0.15 + 0.02 * (i % 9),
+                          i % 2 == 0 ? OptionType::Call : OptionType::Put,
+                          0.02);
+    quotes.push_back(BinomialTree::price(option, 500));
+    option.setVolatility(0.3);
+    chain.push_back(option);
+  }
+  return chain;
+}
+
+// Newton on tree vega from a Barone-Adesi-Whaley guess; the argument is the
+// thread count, items are quotes.
+static void BM_AmericanImpliedVol(benchmark::State &state) {
+  std::vector<double> quotes;
+  const std::vector<AmericanOption> chain = makeAmericanChain(quotes);
+  std::vector<AmericanImpliedVolResult> results(chain.size());
+  for (auto _ : state) {
+    ImpliedVolatility::americanImpliedVolatilityBatch(
+        chain, quotes, results.data(), {}, state.range(0));
+    benchmark::DoNotOptimize(results.data());
+  }
+  int trees = 0;
+  for (const AmericanImpliedVolResult &result : results) {
+    trees += result.treeEvaluations;
+  }
+  state.counters["trees_per_quote"] =
+      static_cast<double>(trees) / static_cast<double>(chain.size());
+  state.SetItemsProcessed(state.iterations() * chain.size());
+}
+BENCHMARK(BM_AmericanImpliedVol)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// The baseline: bisection on full 500-step trees to the same tolerance
+static void BM_AmericanImpliedVolBisection(benchmark::State &state) {
+  std::vector<double> quotes;
+  const std::vector<AmericanOption> chain = makeAmericanChain(quotes);
+  std::vector<double> vols(chain.size());
+  int trees = 0;
+  for (auto _ : state) {
+    trees = 0;
+    for (size_t i = 0; i < chain.size(); ++i) {
+      AmericanOption trial = chain[i];
+      double lo = 1e-3;
+      double hi = 5.0;
+      while (hi - lo > 1e-7) {
+        trial.setVolatility(0.5 * (lo + hi));
+        (BinomialTree::price(trial, 500) > quotes[i] ? hi : lo) =
+            trial.getVolatility();
+        ++trees;
+      }
+      vols[i] = 0.5 * (lo + hi);
+    }
+    benchmark::DoNotOptimize(vols.data());
+  }
+  state.counters["trees_per_quote"] =
+      static_cast<double>(trees) / static_cast<double>(chain.size());
+  state.SetItemsProcessed(state.iterations() * chain.size());
+}
+BENCHMARK(BM_AmericanImpliedVolBisection)->Unit(benchmark::kMillisecond);
+
+// Restart path: map and validate a snapshot of the book, then rebuild every
+// contract with its saved implied vol. Items are contracts.
+static void BM_BookSnapshotRestore(benchmark::State &state) {
+  const std::vector<EuropeanOption> book = makeEuropeanBook(state.range(0));
+  std::vector<SnapshotRecord> records;
+  records.reserve(book.size());
+  for (const EuropeanOption &option : book) {
+    records.push_back(
+        BookSnapshot::record(option, option.getVolatility() + 0.01));
+  }
+  const std::string path = "pricing_benchmarks_snapshot.bin";
+  const std::uint64_t inputs = BookSnapshot::fingerprint("benchmark book");
+  BookSnapshot::save(path, records, inputs);
+  std::vector<EuropeanOption> restored;
+  for (auto _ : state) {
+    const BookSnapshot snapshot = BookSnapshot::open(path, inputs);
+    restored.clear();
+    restored.reserve(snapshot.size());
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+      restored.push_back(snapshot.european(i));
+    }
+    benchmark::DoNotOptimize(restored.data());
+  }
+  std::remove(path.c_str());
+  state.SetItemsProcessed(state.iterations() * book.size());
+}
+BENCHMARK(BM_BookSnapshotRestore)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19)
+    ->Unit(benchmark::kMillisecond);
+
+// Implied vols of a book from the cold 0.2 guess or warm-started from the
+// previous solution after a small market move.
+static void BM_ImpliedVolWarmStart(benchmark::State &state, const bool warm) {
+  const std::vector<EuropeanOption> book = makeEuropeanBook(1024);
+  std::vector<double> prices;
+  for (const EuropeanOption &option : book) {
+    EuropeanOption moved = option;
+    moved.setVolatilityImpl(option.getVolatility() * 1.02);
+    prices.push_back(BlackScholes::price(moved));
+  }
+  std::vector<double> vols(book.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < book.size(); ++i) {
+      vols[i] = ImpliedVolatility::calculateImpliedVolatility(
+          book[i], prices[i], 1e-9, 1000,
+          warm ? book[i].getVolatility() : 0.2);
+    }
+    benchmark::DoNotOptimize(vols.data());
+  }
+  state.SetItemsProcessed(state.iterations() * book.size());
+}
+BENCHMARK_CAPTURE(BM_ImpliedVolWarmStart, Cold, false);
+BENCHMARK_CAPTURE(BM_ImpliedVolWarmStart, Warm, true);
+
+// Overnight risk of a 256-position American book over 32 underlyings on
+// 1-8 worker processes; items are positions.
+static void BM_RiskRunner(benchmark::State &state) {
+  std::vector<RiskPosition<AmericanOption>> book;
+  for (const AmericanOption &option : makeAmericanBook(256)) {
+    book.push_back({static_cast<std::uint32_t>(book.size() % 32), 1.0, option});
+  }
+  RiskRunnerConfig config;
+  config.workers = static_cast<unsigned>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(RiskRunner::run(book, config).total);
+  }
+  state.SetItemsProcessed(state.iterations() * book.size());
+}
+BENCHMARK(BM_RiskRunner)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Black-Scholes over a book laid out per NUMA node and priced by pinned
+// workers; items are options. nodeN_GBps is the read bandwidth of node N's
+// workers streaming their own slices (bytes over the slowest worker's time).
+static void BM_NumaBookPricing(benchmark::State &state) {
+  const NumaTopology topology = Numa::discover();
+  NumaBook<EuropeanOption> book(makeEuropeanBook(state.range(0)), topology);
+  const NumaBook<EuropeanOption>::Kernel price =
+      [](const size_t, const std::vector<EuropeanOption> &options,
+         double *prices) { BlackScholes::priceBatch(options, prices); };
+  for (auto _ : state) {
+    book.run(price);
+  }
+  state.SetItemsProcessed(state.iterations() * book.size());
+
+  constexpr int kPasses = 8;
+  const size_t nodes = topology.nodes.size();
+  std::vector<std::atomic<size_t>> bytes(nodes);
+  std::vector<std::atomic<long long>> slowest(nodes);
+  book.run([&](const size_t node, const std::vector<EuropeanOption> &options,
+               double *) {
+    const auto start = std::chrono::steady_clock::now();
+    double sum = 0.0;
+    for (int pass = 0; pass < kPasses; ++pass) {
+      for (const EuropeanOption &option : options) {
+        sum += option.getStrikePrice();
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    const long long elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    bytes[node] += kPasses * options.size() * sizeof(EuropeanOption);
+    long long seen = slowest[node];
+    while (seen < elapsed &&
+           !slowest[node].compare_exchange_weak(seen, elapsed)) {
+    }
+  });
+  for (size_t n = 0; n < nodes; ++n) {
+    state.counters["node" + std::to_string(topology.nodes[n].id) + "_GBps"] =
+        static_cast<double>(bytes[n]) / static_cast<double>(slowest[n]);
+  }
+}
+BENCHMARK(BM_NumaBookPricing)
+    ->Range(1 << 16, 1 << 22)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// The same book allocated by one thread and priced in chunks by unpinned
+// Parallel::forEach workers, the baseline for BM_NumaBookPricing. The chunks
+// are split off before timing, so the loop only prices.
+static void BM_FlatBookPricing(benchmark::State &state) {
+  constexpr size_t kChunk = 4096;
+  const std::vector<EuropeanOption> book = makeEuropeanBook(state.range(0));
+  std::vector<double> prices(book.size());
+  std::vector<std::vector<EuropeanOption>> chunks;
+  for (size_t first = 0; first < book.size(); first += kChunk) {
+    chunks.emplace_back(book.begin() + first,
+                        book.begin() + std::min(first + kChunk, book.size()));
+  }
+  for (auto _ : state) {
+    Parallel::forEach(chunks.size(), [&](const size_t chunk) {
+      BlackScholes::priceBatch(chunks[chunk], prices.data() + chunk * kChunk);
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * book.size());
+}
+BENCHMARK(BM_FlatBookPricing)
+    ->Range(1 << 16, 1 << 22)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// 64 snapshots of 16 underlyings (4 expiries x 15 strikes of OTM quotes on a
+// smile), in DataParser's text format, and a 512-position book on them
+static std::vector<std::string> makeQuoteSnapshots() {
+  std::vector<std::string> snapshots;
+  for (int i = 0; i < 64; ++i) {
+    const double spot = 95.0 + i % 11;
+    std::ostringstream text;
+    text << std::setprecision(17) << i % 16 << ',' << spot << ",0.03\n";
+    for (const double maturity : {0.25, 0.5, 1.0, 2.0}) {
+      for (double strike = 70.0; strike <= 140.0; strike += 5.0) {
+        const double k = std::log(strike / (spot * std::exp(0.03 * maturity)));
+        const OptionType type =
+            strike >= spot ? OptionType::Call : OptionType::Put;
+        const EuropeanOption option(spot, strike, 0.03, maturity,
+                                    0.22 - 0.08 * k + 0.25 * k * k, type);
+        text << (type == OptionType::Call ? 'C' : 'P') << ',' << strike
+             << ',' << maturity << ',' << BlackScholes::price(option) << '\n';
+      }
+    }
+    snapshots.push_back(text.str());
+  }
+  return snapshots;
+}
+
+static std::vector<RiskPosition<EuropeanOption>> makePipelineBook() {
+  std::vector<RiskPosition<EuropeanOption>> book;
+  for (const EuropeanOption &option : makeEuropeanBook(512)) {
+    book.push_back({static_cast<std::uint32_t>(book.size() % 16), 1.0, option});
+  }
+  return book;
+}
+
+// Quotes to book risk, one snapshot at a time through each step in turn;
+// items are snapshots.
+static void BM_QuoteBatchFlow(benchmark::State &state) {
+  const std::vector<std::string> snapshots = makeQuoteSnapshots();
+  const std::vector<RiskPosition<EuropeanOption>> book = makePipelineBook();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(QuotePipeline::runSerial(book, snapshots));
+  }
+  state.SetItemsProcessed(state.iterations() * snapshots.size());
+}
+BENCHMARK(BM_QuoteBatchFlow)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// The same flow through QuotePipeline with range(0) inversion threads (the
+// usual hot stage) and one thread on each other stage. Per stage, X_per_s is
+// its capacity (snapshots over busy time per thread) and X_peak the deepest
+// its input queue got; latency_us is the mean submit-to-risk time.
+static void BM_QuotePipeline(benchmark::State &state) {
+  static const char *kStageNames[] = {"parse", "invert", "fit", "risk"};
+  const std::vector<std::string> snapshots = makeQuoteSnapshots();
+  QuotePipelineConfig config;
+  config.threads[static_cast<size_t>(PipelineStage::Invert)] =
+      static_cast<unsigned>(state.range(0));
+  std::atomic<long long> latency{0};
+  QuotePipeline pipeline(
+      makePipelineBook(),
+      [&](const QuotePipelineResult &result, const std::exception_ptr &) {
+        latency += result.latency.count();
+      },
+      config);
+  for (auto _ : state) {
+    for (const std::string &snapshot : snapshots) {
+      pipeline.submit(snapshot);
+    }
+    pipeline.drain();
+  }
+  state.SetItemsProcessed(state.iterations() * snapshots.size());
+
+  const QuotePipelineStats stats = pipeline.stats();
+  for (size_t stage = 0; stage < stats.stages.size(); ++stage) {
+    const PipelineStageStats &counters = stats.stages[stage];
+    const std::string name = kStageNames[stage];
+    state.counters[name + "_per_s"] =
+        counters.snapshots * config.threads[stage] /
+        std::chrono::duration<double>(counters.busy).count();
+    state.counters[name + "_peak"] =
+        static_cast<double>(counters.peakQueueDepth);
+  }
+  state.counters["latency_us"] =
+      latency * 1e-3 / static_cast<double>(stats.completed);
+}
+BENCHMARK(BM_QuotePipeline)
+    ->RangeMultiplier(2)
+    ->Range(1, 4)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// 64k European positions over 64 underlyings, bucketed into 6 expiries x 8
+// moneyness bands; items are positions.
+static std::vector<RiskPosition<EuropeanOption>> makePortfolioBook() {
+  std::vector<RiskPosition<EuropeanOption>> book;
+  for (const EuropeanOption &option : makeEuropeanBook(1 << 16)) {
+    book.push_back({static_cast<std::uint32_t>(book.size() % 64),
+                    1.0 + static_cast<double>(book.size() % 5), option});
+  }
+  return book;
+}
+
+static const GreekBuckets kPortfolioBuckets{
+    {0.25, 0.5, 1.0, 2.0, 5.0}, {0.8, 0.9, 0.95, 1.0, 1.05, 1.1, 1.2}};
+
+// Greeks priced per position, then bucketed in a second single-threaded
+// pass through a map, the way callers aggregated before PortfolioAggregator.
+static void BM_PortfolioGreeksTwoPass(benchmark::State &state) {
+  const std::vector<RiskPosition<EuropeanOption>> book = makePortfolioBook();
+  const auto bucket = [](const std::vector<double> &edges, const double &v) {
+    return std::upper_bound(edges.begin(), edges.end(), v) - edges.begin();
+  };
+  std::vector<RiskMeasures> positions(book.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < book.size(); ++i) {
+      positions[i] = RiskRunner::measure(book[i].option, 0);
+    }
+    std::map<std::tuple<std::uint32_t, long, long>, RiskMeasures> cells;
+    for (size_t i = 0; i < book.size(); ++i) {
+      const EuropeanOption &option = book[i].option;
+      RiskMeasures &cell = cells[{
+          book[i].underlying,
+          bucket(kPortfolioBuckets.expiryEdges, option.getMaturity()),
+          bucket(kPortfolioBuckets.moneynessEdges,
+                 option.getStrikePrice() / option.getSpotPrice())}];
+      cell.delta += book[i].quantity * positions[i].delta;
+      cell.gamma += book[i].quantity * positions[i].gamma;
+      cell.vega += book[i].quantity * positions[i].vega;
+      cell.theta += book[i].quantity * positions[i].theta;
+    }
+    benchmark::DoNotOptimize(cells.size());
+  }
+  state.SetItemsProcessed(state.iterations() * book.size());
+}
+BENCHMARK(BM_PortfolioGreeksTwoPass)->Unit(benchmark::kMillisecond);
+
+// PortfolioAggregator on range(0) threads.
+static void BM_PortfolioGreeks(benchmark::State &state) {
+  const std::vector<RiskPosition<EuropeanOption>> book = makePortfolioBook();
+  PortfolioRiskConfig config;
+  config.threads = static_cast<unsigned>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        PortfolioAggregator::aggregate(book, kPortfolioBuckets, config).total);
+  }
+  state.SetItemsProcessed(state.iterations() * book.size());
+}
+BENCHMARK(BM_PortfolioGreeks)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Open-loop load generator: requests are submitted on a fixed schedule at the
+// offered rate (args: requests/s, max batch size, max batch delay in us) and
+// latency is measured from the scheduled send time, so a stalled service is
+// charged for the requests queued behind it.
+static void BM_PricingServiceLatency(benchmark::State &state) {
+  using Clock = std::chrono::steady_clock;
+  constexpr size_t kRequests = 20000;
+  const auto interval = std::chrono::nanoseconds(
+      static_cast<long long>(1e9 / static_cast<double>(state.range(0))));
+
+  PricingServiceConfig config;
+  config.maxBatchSize = state.range(1);
+  config.maxBatchDelay = std::chrono::microseconds(state.range(2));
+  const EuropeanOption option(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call);
+
+  std::vector<double> latencies(kRequests);
+  size_t batches = 0;
+  for (auto _ : state) {
+    PricingService service(config);
+    std::atomic<size_t> done{0};
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < kRequests; ++i) {
+      const Clock::time_point scheduled = start + i * interval;
+      while (Clock::now() < scheduled) {
+        std::this_thread::yield();
+      }
+      service.submit(option, [&latencies, &done, i,
+                              scheduled](const double &,
+                                         const std::exception_ptr &) {
+        latencies[i] = std::chrono::duration<double, std::micro>(
+                           Clock::now() - scheduled)
+                           .count();
+        done.fetch_add(1, std::memory_order_release);
+      });
+    }
+    while (done.load(std::memory_order_acquire) < kRequests) {
+      std::this_thread::yield();
+    }
+    batches = service.stats().batches;
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto percentile = [&latencies](const double &p) {
+    return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+  };
+  state.counters["p50_us"] = percentile(0.50);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["p999_us"] = percentile(0.999);
+  state.counters["mean_batch"] =
+      static_cast<double>(kRequests) / std::max<size_t>(batches, 1);
+  state.SetItemsProcessed(state.iterations() * kRequests);
+}
+BENCHMARK(BM_PricingServiceLatency)
+    ->Args({100000, 256, 20})
+    ->Args({500000, 256, 20})
+    ->Args({500000, 32, 5})
+    ->Args({1000000, 512, 50})
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -15,12 +15,125 @@ namespace ErrorMessages {
 
   namespace BinomialTree {
     constexpr auto kInvalidNumSteps = "Number of steps must be positive.";
+    constexpr auto kInvalidWavefrontConfig =
+        "Wavefront tile width and block steps must be positive.";
+  } // namespace BinomialTree
+
+  namespace AnalyticAmerican {
+    constexpr auto kInvalidBoundaryConfig =
+        "Exercise boundary needs positive node counts and a non-negative "
+        "iteration count.";
+  }
+
+  namespace Proxy {
+    constexpr auto kInvalidBox =
+        "Proxy box needs positive lower bounds below the upper bounds.";
+    constexpr auto kInvalidNodes =
+        "Proxy node counts must be positive and at most 64.";
+    constexpr auto kUnreadableFile = "Proxy file could not be opened.";
+    constexpr auto kUnwritableFile = "Proxy file could not be written.";
+    constexpr auto kCorruptFile =
+        "Proxy file is truncated or of an unknown format.";
+  } // namespace Proxy
+
+  namespace Heston {
+    constexpr auto kInvalidParameters =
+        "Heston parameters need v0, theta >= 0, kappa, vol of vol > 0 and "
+        "|rho| <= 1.";
+    constexpr auto kMixedStrip = "A strike strip must share spot, rate, "
+                                 "dividend yield and maturity.";
+    constexpr auto kInvalidStripConfig =
+        "Strip pricing needs positive term counts and spacings, and a "
+        "power-of-two FFT size.";
+  } // namespace Heston
+
+  namespace NumericalMethods {
+    constexpr auto kInvalidFftSize = "FFT size must be a power of two.";
   }
 
   namespace ImpliedVol {
     constexpr auto kInvalidMarketPrice = "Market price must be positive.";
+    constexpr auto kInvalidAmericanConfig =
+        "American implied volatility needs positive step counts, tolerances "
+        "and iteration budgets and 0 < minVolatility < maxVolatility.";
+    constexpr auto kMismatchedQuotes = "Need one market price per option.";
+  } // namespace ImpliedVol
+
+  namespace TermStructure {
+    constexpr auto kMismatchedCurveData =
+        "Yield curve needs the same non-zero number of times and rates.";
+    constexpr auto kInvalidCurvePillars =
+        "Yield curve pillar times must be positive and increasing.";
+    constexpr auto kInvalidDividend =
+        "Dividend times and amounts must be non-negative.";
+  } // namespace TermStructure
+
+  namespace Scenario {
+    constexpr auto kEmptyShockGrid =
+        "Shock grid needs at least one spot, vol and rate shock.";
+    constexpr auto kInvalidSpotShock = "Spot shocks must be above -100%.";
+  } // namespace Scenario
+
+  namespace Service {
+    constexpr auto kInvalidBatchSize = "Maximum batch size must be positive.";
   }
 
+  namespace Snapshot {
+    constexpr auto kUnreadableFile = "Snapshot file could not be opened.";
+    constexpr auto kUnwritableFile = "Snapshot file could not be written.";
+    constexpr auto kCorruptFile =
+        "Snapshot file is truncated, of another format version or fails its "
+        "checksum.";
+    constexpr auto kStaleInputs =
+        "Snapshot was taken from other book or market inputs.";
+    constexpr auto kWrongExerciseStyle =
+        "Snapshot record is of another exercise style.";
+  } // namespace Snapshot
+
+  namespace Risk {
+    constexpr auto kInvalidConfig =
+        "Risk runner needs positive workers, shards per worker, timeout, "
+        "attempts and steps.";
+    constexpr auto kSharedMemory = "Risk results region could not be mapped.";
+    constexpr auto kForkFailed = "Risk worker process could not be started.";
+    constexpr auto kShardFailed =
+        "A risk shard crashed or timed out on every attempt.";
+  } // namespace Risk
+
+  namespace Numa {
+    constexpr auto kInvalidCpuList = "Malformed CPU list.";
+    constexpr auto kEmptyTopology =
+        "NUMA topology needs at least one node, and CPUs on every node.";
+  } // namespace Numa
+
+  namespace Parser {
+    constexpr auto kMalformedHeader =
+        "Snapshot header must be \"underlying,spot,rate\".";
+    constexpr auto kMalformedQuote =
+        "Quote line must be \"C|P,strike,maturity,price\".";
+  } // namespace Parser
+
+  namespace Surface {
+    constexpr auto kMismatchedSurfaceData =
+        "Need one strike, maturity and volatility per surface point.";
+    constexpr auto kInvalidSurfacePoint = "Surface points need positive "
+                                          "strikes, maturities and vols.";
+  } // namespace Surface
+
+  namespace Pipeline {
+    constexpr auto kInvalidConfig =
+        "Pipeline needs a positive queue capacity and threads per stage.";
+    constexpr auto kNoImpliedVols =
+        "No quote in the snapshot implied a volatility.";
+  } // namespace Pipeline
+
+  namespace Portfolio {
+    constexpr auto kInvalidBuckets =
+        "Bucket edges must be finite and strictly ascending.";
+    constexpr auto kInvalidConfig =
+        "Portfolio chunk size and lattice steps must be positive.";
+  } // namespace Portfolio
+
 } // namespace ErrorMessages
 
 #endif // ERROR_MESSAGES_H
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef DIVIDEND_SCHEDULE_H
+#define DIVIDEND_SCHEDULE_H
+
+#include "market/yield_curve.h"
+
+struct Dividend {
+  double time;   // ex-dividend time in years from today
+  double amount; // cash amount
+};
+
+// Discrete cash dividends, priced with the escrowed-dividend model: the
+// engines diffuse S minus the present value of the dividends paid before
+// expiry and add back the value of the ones still to come at each node.
+class DividendSchedule {
+public:
+  DividendSchedule() = default;
+
+  explicit DividendSchedule(std::vector<Dividend> dividends);
+
+  [[nodiscard]] bool empty() const { return dividends_.empty(); }
+
+  [[nodiscard]] const std::vector<Dividend> &getDividends() const {
+    return dividends_;
+  }
+
+  // value today of the dividends paid in (from, to]
+  [[nodiscard]] double presentValue(const YieldCurve &curve, const double &from,
+                                    const double &to) const;
+
+  // value at t_i = i * T / numSteps of the dividends paid in (t_i, T], for i
+  // in [0, numSteps]
+  [[nodiscard]] std::vector<double>
+  remainingValueTable(const YieldCurve &curve, const double &T,
+                      const int &numSteps) const;
+
+  // the same from a curve.discountTable(T, numSteps) the caller already
+  // holds, so a lattice builds its discount table once
+  [[nodiscard]] std::vector<double>
+  remainingValueTable(const YieldCurve &curve, const double &T,
+                      const std::vector<double> &discounts) const;
+
+private:
+  std::vector<Dividend> dividends_; // sorted by time
+};
+
+#endif // DIVIDEND_SCHEDULE_H
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef VOL_SURFACE_H
+#define VOL_SURFACE_H
+
+#include <common.h>
+
+// Implied volatility surface fitted to one snapshot of a chain. Each expiry
+// gets a least-squares quadratic smile in log-moneyness ln(K / F), with the
+// forward F = S e^{(r - q)T} of the spot, rate and dividend yield, held flat
+// beyond the strikes it was fitted on; between expiries the total variance
+// sigma^2 T is interpolated linearly, and beyond the first and last expiry the
+// nearest smile is used as is. Surfaces are immutable, so one instance can
+// be shared by every position on the underlying.
+class VolSurface {
+public:
+  VolSurface(const double &spot, const double &rate,
+             const std::vector<double> &strikes,
+             const std::vector<double> &maturities,
+             const std::vector<double> &vols,
+             const double &dividendYield = 0.0);
+
+  [[nodiscard]] double volatility(const double &strike,
+                                  const double &maturity) const;
+
+  // fitted expiries, ascending
+  [[nodiscard]] const std::vector<double> &expiries() const {
+    return expiries_;
+  }
+
+private:
+  // vol = a + b k + c k^2 for k in [kMin, kMax]
+  struct Smile {
+    double a;
+    double b;
+    double c;
+    double kMin;
+    double kMax;
+  };
+
+  static Smile fitSmile(const std::vector<double> &k,
+                        const std::vector<double> &vols);
+
+  [[nodiscard]] double smileVolatility(const size_t &expiry,
+                                       const double &strike) const;
+
+  double spot_;
+  double rate_;
+  double dividendYield_;
+  std::vector<double> expiries_;
+  std::vector<Smile> smiles_; // one per expiry
+};
+
+#endif // VOL_SURFACE_H
\ No newline at end of file
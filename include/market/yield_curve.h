@@ -0,0 +1,35 @@
+#ifndef YIELD_CURVE_H
+#define YIELD_CURVE_H
+
+#include <common.h>
+
+// Continuously compounded zero curve, interpolated linearly in log-discount
+// (piecewise-flat forwards) and extrapolated with the last forward. Curves are
+// immutable, so one instance can be shared by every contract on it.
+class YieldCurve {
+public:
+  YieldCurve(const std::vector<double> &times,
+             const std::vector<double> &zero_rates);
+
+  static YieldCurve flat(const double &rate);
+
+  [[nodiscard]] double discount(const double &t) const;
+
+  [[nodiscard]] double zeroRate(const double &t) const;
+
+  [[nodiscard]] double forwardRate(const double &t1, const double &t2) const;
+
+  // discount(i * T / numSteps) for i in [0, numSteps], built in a single pass
+  // over the pillars so lattice engines get O(1) lookups per time step
+  [[nodiscard]] std::vector<double> discountTable(const double &T,
+                                                  const int &numSteps) const;
+
+private:
+  [[nodiscard]] double logDiscount(const double &t,
+                                   const size_t &segment) const;
+
+  std::vector<double> times_;         // pillar times, times_[0] == 0
+  std::vector<double> log_discounts_; // log discount factor at each pillar
+};
+
+#endif // YIELD_CURVE_H
\ No newline at end of file
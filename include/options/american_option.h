@@ -3,40 +3,58 @@
 
 #include "option.h"
 
-class AmericanOption final : public Option<AmericanOption> {
+template <typename Real>
+class BasicAmericanOption final
+    : public Option<BasicAmericanOption<Real>, Real> {
 public:
-  AmericanOption(const double &spot_price, const double &strike_price,
-                 const double &risk_free_rate, const double &time_to_maturity,
-                 const double &sigma, const OptionType &type,
-                 const double &dividend_yield = 0.0);
+  BasicAmericanOption(const Real &spot_price, const Real &strike_price,
+                      const Real &risk_free_rate, const Real &time_to_maturity,
+                      const Real &sigma, const OptionType &type,
+                      const Real &dividend_yield = Real(0));
 
-  ~AmericanOption() override = default;
+  ~BasicAmericanOption() override = default;
 
-  void setVolatility(const double &sigma) { sigma_ = sigma; }
+  void setVolatility(const Real &sigma) { this->sigma_ = sigma; }
 
-  void setSpotPrice(const double &spot_price) { spot_price_ = spot_price; }
+  void setSpotPrice(const Real &spot_price) { this->spot_price_ = spot_price; }
 
-  void setMaturity(const double &time_to_maturity) {
-    time_to_maturity_ = time_to_maturity;
+  void setMaturity(const Real &time_to_maturity) {
+    this->time_to_maturity_ = time_to_maturity;
   }
 
-  [[nodiscard]] double getVolatilityImpl() const { return sigma_; }
+  [[nodiscard]] Real getVolatilityImpl() const { return this->sigma_; }
 
-  [[nodiscard]] double getSpotPriceImpl() const { return spot_price_; }
+  [[nodiscard]] Real getSpotPriceImpl() const { return this->spot_price_; }
 
-  [[nodiscard]] double getStrikePriceImpl() const { return strike_price_; }
+  [[nodiscard]] Real getStrikePriceImpl() const {
+    return this->strike_price_;
+  }
 
-  [[nodiscard]] double getRiskFreeRateImpl() const { return risk_free_rate_; }
+  [[nodiscard]] Real getRiskFreeRateImpl() const {
+    return this->risk_free_rate_;
+  }
 
-  [[nodiscard]] double getMaturityImpl() const { return time_to_maturity_; }
+  [[nodiscard]] Real getMaturityImpl() const {
+    return this->time_to_maturity_;
+  }
 
-  [[nodiscard]] OptionType getTypeImpl() const { return type_; }
+  [[nodiscard]] OptionType getTypeImpl() const { return this->type_; }
 
-  [[nodiscard]] double getDividendYieldImpl() const { return dividend_yield_; }
+  [[nodiscard]] Real getDividendYieldImpl() const {
+    return this->dividend_yield_;
+  }
 
-  [[nodiscard]] double payoffImpl(const double &underlying_price) const;
+  [[nodiscard]] Real payoffImpl(const Real &underlying_price) const;
 
   static bool isAmericanImpl() { return true; }
+
+  static constexpr ExerciseStyle kExerciseStyle = ExerciseStyle::American;
 };
 
+extern template class BasicAmericanOption<float>;
+extern template class BasicAmericanOption<double>;
+
+using AmericanOption = BasicAmericanOption<double>;
+using AmericanOptionF = BasicAmericanOption<float>;
+
 #endif // AMERICAN_OPTION_H
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef BERMUDAN_OPTION_H
+#define BERMUDAN_OPTION_H
+
+#include "option.h"
+
+// Exercisable on a discrete schedule of times (in years from today) and at
+// maturity.
+template <typename Real>
+class BasicBermudanOption final
+    : public Option<BasicBermudanOption<Real>, Real> {
+public:
+  BasicBermudanOption(const Real &spot_price, const Real &strike_price,
+                      const Real &risk_free_rate, const Real &time_to_maturity,
+                      const Real &sigma, const OptionType &type,
+                      std::vector<Real> exercise_times,
+                      const Real &dividend_yield = Real(0));
+
+  ~BasicBermudanOption() override = default;
+
+  void setVolatility(const Real &sigma) { this->sigma_ = sigma; }
+
+  void setSpotPrice(const Real &spot_price) { this->spot_price_ = spot_price; }
+
+  void setMaturity(const Real &time_to_maturity) {
+    this->time_to_maturity_ = time_to_maturity;
+  }
+
+  [[nodiscard]] Real getVolatilityImpl() const { return this->sigma_; }
+
+  [[nodiscard]] Real getSpotPriceImpl() const { return this->spot_price_; }
+
+  [[nodiscard]] Real getStrikePriceImpl() const {
+    return this->strike_price_;
+  }
+
+  [[nodiscard]] Real getRiskFreeRateImpl() const {
+    return this->risk_free_rate_;
+  }
+
+  [[nodiscard]] Real getMaturityImpl() const {
+    return this->time_to_maturity_;
+  }
+
+  [[nodiscard]] OptionType getTypeImpl() const { return this->type_; }
+
+  [[nodiscard]] Real getDividendYieldImpl() const {
+    return this->dividend_yield_;
+  }
+
+  [[nodiscard]] const std::vector<Real> &getExerciseTimes() const {
+    return exercise_times_;
+  }
+
+  [[nodiscard]] Real payoffImpl(const Real &underlying_price) const;
+
+  [[nodiscard]] static bool isAmericanImpl() { return false; }
+
+  static constexpr ExerciseStyle kExerciseStyle = ExerciseStyle::Bermudan;
+
+private:
+  std::vector<Real> exercise_times_; // sorted ascending
+};
+
+extern template class BasicBermudanOption<float>;
+extern template class BasicBermudanOption<double>;
+
+using BermudanOption = BasicBermudanOption<double>;
+using BermudanOptionF = BasicBermudanOption<float>;
+
+#endif // BERMUDAN_OPTION_H
\ No newline at end of file
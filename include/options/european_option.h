@@ -3,34 +3,58 @@
 
 #include "option.h"
 
-class EuropeanOption final : public Option<EuropeanOption> {
+template <typename Real>
+class BasicEuropeanOption final
+    : public Option<BasicEuropeanOption<Real>, Real> {
 public:
-  EuropeanOption(const double &spot_price, const double &strike_price,
-                 const double &risk_free_rate, const double &time_to_maturity,
-                 const double &sigma, const OptionType &type,
-                 const double &dividend_yield = 0.0);
+  BasicEuropeanOption(const Real &spot_price, const Real &strike_price,
+                      const Real &risk_free_rate, const Real &time_to_maturity,
+                      const Real &sigma, const OptionType &type,
+                      const Real &dividend_yield = Real(0));
 
-  ~EuropeanOption() override = default;
+  ~BasicEuropeanOption() override = default;
 
-  void setVolatilityImpl(const double &sigma);
+  void setVolatilityImpl(const Real &sigma);
 
-  [[nodiscard]] double getVolatilityImpl() const { return sigma_; }
+  void setSpotPrice(const Real &spot_price) { this->spot_price_ = spot_price; }
 
-  [[nodiscard]] double getSpotPriceImpl() const { return spot_price_; }
+  void setMaturity(const Real &time_to_maturity) {
+    this->time_to_maturity_ = time_to_maturity;
+  }
 
-  [[nodiscard]] double getStrikePriceImpl() const { return strike_price_; }
+  [[nodiscard]] Real getVolatilityImpl() const { return this->sigma_; }
 
-  [[nodiscard]] double getRiskFreeRateImpl() const { return risk_free_rate_; }
+  [[nodiscard]] Real getSpotPriceImpl() const { return this->spot_price_; }
 
-  [[nodiscard]] double getMaturityImpl() const { return time_to_maturity_; }
+  [[nodiscard]] Real getStrikePriceImpl() const {
+    return this->strike_price_;
+  }
 
-  [[nodiscard]] OptionType getTypeImpl() const { return type_; }
+  [[nodiscard]] Real getRiskFreeRateImpl() const {
+    return this->risk_free_rate_;
+  }
 
-  [[nodiscard]] double getDividendYieldImpl() const { return dividend_yield_; }
+  [[nodiscard]] Real getMaturityImpl() const {
+    return this->time_to_maturity_;
+  }
 
-  [[nodiscard]] double payoffImpl(const double &underlying_price) const;
+  [[nodiscard]] OptionType getTypeImpl() const { return this->type_; }
+
+  [[nodiscard]] Real getDividendYieldImpl() const {
+    return this->dividend_yield_;
+  }
+
+  [[nodiscard]] Real payoffImpl(const Real &underlying_price) const;
 
   [[nodiscard]] static bool isAmericanImpl() { return false; }
+
+  static constexpr ExerciseStyle kExerciseStyle = ExerciseStyle::European;
 };
 
+extern template class BasicEuropeanOption<float>;
+extern template class BasicEuropeanOption<double>;
+
+using EuropeanOption = BasicEuropeanOption<double>;
+using EuropeanOptionF = BasicEuropeanOption<float>;
+
 #endif // EUROPEAN_OPTION_H
\ No newline at end of file
@@ -5,35 +5,41 @@
 
 enum class OptionType { Call, Put };
 
-template <typename Derived> class Option {
+enum class ExerciseStyle { European, American, Bermudan };
+
+// Real is the scalar type of the contract terms and of the engines that price
+// it: double, or float for screening workloads
+template <typename Derived, typename Real = double> class Option {
 public:
-  Option(const double &spot_price, const double &strike_price,
-         const double &risk_free_rate, const double &time_to_maturity,
-         const double &sigma, const OptionType &type,
-         const double &dividend_yield = 0.0)
+  using value_type = Real;
+
+  Option(const Real &spot_price, const Real &strike_price,
+         const Real &risk_free_rate, const Real &time_to_maturity,
+         const Real &sigma, const OptionType &type,
+         const Real &dividend_yield = Real(0))
       : spot_price_(spot_price), strike_price_(strike_price),
         risk_free_rate_(risk_free_rate), time_to_maturity_(time_to_maturity),
         sigma_(sigma), type_(type), dividend_yield_(dividend_yield) {}
 
   virtual ~Option() = default;
 
-  [[nodiscard]] double getVolatility() const {
+  [[nodiscard]] Real getVolatility() const {
     return static_cast<const Derived *>(this)->getVolatilityImpl();
   }
 
-  [[nodiscard]] double getSpotPrice() const {
+  [[nodiscard]] Real getSpotPrice() const {
     return static_cast<const Derived *>(this)->getSpotPriceImpl();
   }
 
-  [[nodiscard]] double getStrikePrice() const {
+  [[nodiscard]] Real getStrikePrice() const {
     return static_cast<const Derived *>(this)->getStrikePriceImpl();
   }
 
-  [[nodiscard]] double getRiskFreeRate() const {
+  [[nodiscard]] Real getRiskFreeRate() const {
     return static_cast<const Derived *>(this)->getRiskFreeRateImpl();
   }
 
-  [[nodiscard]] double getMaturity() const {
+  [[nodiscard]] Real getMaturity() const {
     return static_cast<const Derived *>(this)->getMaturityImpl();
   }
 
@@ -41,11 +47,11 @@ public:
     return static_cast<const Derived *>(this)->getTypeImpl();
   }
 
-  [[nodiscard]] double getDividendYield() const {
+  [[nodiscard]] Real getDividendYield() const {
     return static_cast<const Derived *>(this)->getDividendYieldImpl();
   }
 
-  [[nodiscard]] double payoff(double underlying_price) const {
+  [[nodiscard]] Real payoff(Real underlying_price) const {
     return static_cast<const Derived *>(this)->payoffImpl(underlying_price);
   }
 
@@ -54,13 +60,13 @@ public:
   }
 
 protected:
-  double spot_price_;
-  double strike_price_;
-  double risk_free_rate_;
-  double time_to_maturity_;
-  double sigma_;
+  Real spot_price_;
+  Real strike_price_;
+  Real risk_free_rate_;
+  Real time_to_maturity_;
+  Real sigma_;
   OptionType type_;
-  double dividend_yield_;
+  Real dividend_yield_;
 
 private:
   // for compile-time polymorphism (lite version of CRTP)
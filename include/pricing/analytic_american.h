@@ -0,0 +1,55 @@
+#ifndef ANALYTIC_AMERICAN_H
+#define ANALYTIC_AMERICAN_H
+
+#include "options/american_option.h"
+
+enum class AmericanApproximation {
+  // quadratic approximation of the early exercise premium (1987)
+  BaroneAdesiWhaley,
+  // two-step flat exercise boundary (2002)
+  BjerksundStensland,
+  // fixed-point iteration on the integral equation for the exercise
+  // boundary (Andersen-Lake-Offengenden)
+  ExerciseBoundary
+};
+
+// Discretization of the exercise boundary solver. The boundary is
+// interpolated in sqrt(time to expiry) through collocationNodes + 1
+// Chebyshev points; each fixed-point iteration re-evaluates it at every
+// node, so iterations trades latency for accuracy directly.
+struct ExerciseBoundaryConfig {
+  int collocationNodes = 8;
+  int iterations = 6;
+  // Gauss-Legendre points per boundary integral
+  int integrationNodes = 24;
+  // Gauss-Legendre points for the early exercise premium
+  int pricingNodes = 48;
+};
+
+// Closed-form and semi-analytic American prices, orders of magnitude
+// cheaper than a lattice. Calls are priced through put-call symmetry where
+// the method is stated for puts and vice versa.
+class AnalyticAmerican {
+public:
+  static double price(const AmericanOption &option,
+                      const AmericanApproximation &method,
+                      const ExerciseBoundaryConfig &config = {});
+
+  static double baroneAdesiWhaley(const AmericanOption &option);
+  static double bjerksundStensland(const AmericanOption &option);
+  static double exerciseBoundary(const AmericanOption &option,
+                                 const ExerciseBoundaryConfig &config = {});
+
+  // Prices a whole book into prices[0, options.size()) on up to `threads`
+  // threads (0 picks Parallel::defaultThreadCount()).
+  static void priceBatch(const std::vector<AmericanOption> &options,
+                         double *prices, const AmericanApproximation &method,
+                         const ExerciseBoundaryConfig &config = {},
+                         const unsigned &threads = 1);
+
+private:
+  static void validate(const AmericanOption &option);
+  static void validate(const ExerciseBoundaryConfig &config);
+};
+
+#endif // ANALYTIC_AMERICAN_H
\ No newline at end of file
@@ -1,21 +1,184 @@
 #ifndef BINOMIAL_TREE_H
 #define BINOMIAL_TREE_H
 
+#include "market/dividend_schedule.h"
+#include "market/yield_curve.h"
 #include "options/american_option.h"
+#include "options/bermudan_option.h"
+#include "options/european_option.h"
 
+// Tiling of the parallel single-tree mode. A tile covers tileWidth nodes of
+// a time slice and advances blockSteps levels between synchronizations, so
+// its working set is about tileWidth + blockSteps values and every tile
+// recomputes blockSteps^2 / 2 nodes of its right neighbour.
+struct WavefrontConfig {
+  int tileWidth = 4096;
+  int blockSteps = 128;
+};
+
+// A lattice price with its exact derivative with respect to volatility.
+struct LatticeSensitivity {
+  double price;
+  double vega;
+};
+
+// Cox-Ross-Rubinstein lattice. The backward induction is instantiated per
+// (option type, call/put, exercise style, scalar type) so the per-node loop
+// carries no branches; the public overloads dispatch on call/put once per
+// call. Float and double are instantiated.
 class BinomialTree {
 public:
-  static double price(const AmericanOption &option, const int &numSteps);
+  template <typename Real>
+  static Real price(const BasicAmericanOption<Real> &option,
+                    const int &numSteps);
+  template <typename Real>
+  static Real price(const BasicEuropeanOption<Real> &option,
+                    const int &numSteps);
+  template <typename Real>
+  static Real price(const BasicBermudanOption<Real> &option,
+                    const int &numSteps);
+
+  // Term-structured rates and discrete cash dividends. The option's own flat
+  // rate is ignored; its continuous dividend yield still applies.
+  static double price(const AmericanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double price(const EuropeanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double price(const BermudanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+
+  // One very large tree on up to `threads` threads (0 = all cores), for
+  // convergence studies and reference prices at N in the tens of thousands.
+  // The result is bit-identical to price(option, numSteps).
+  template <typename Real>
+  static Real priceParallel(const BasicAmericanOption<Real> &option,
+                            const int &numSteps, const unsigned &threads = 0,
+                            const WavefrontConfig &config = {});
+  template <typename Real>
+  static Real priceParallel(const BasicEuropeanOption<Real> &option,
+                            const int &numSteps, const unsigned &threads = 0,
+                            const WavefrontConfig &config = {});
+  template <typename Real>
+  static Real priceParallel(const BasicBermudanOption<Real> &option,
+                            const int &numSteps, const unsigned &threads = 0,
+                            const WavefrontConfig &config = {});
+
+  // Options interleaved per batch lane group: one node row of the lane-major
+  // buffer is a cache line.
+  template <typename Real>
+  static constexpr int kBatchLanes = static_cast<int>(64 / sizeof(Real));
+
+  // Prices a whole book into prices[0, options.size()), kBatchLanes options
+  // at a time with per-lane u, d, p and strike, so the backward induction
+  // runs one fixed-width loop across the lanes at every node. Each price
+  // equals price(option, numSteps); lane groups are spread over up to
+  // `threads` threads (0 = all cores). Contracts are not validated.
+  template <typename Real>
+  static void priceBatch(const std::vector<BasicAmericanOption<Real>> &options,
+                         const int &numSteps, Real *prices,
+                         const unsigned &threads = 1);
 
-  static double delta(const AmericanOption &option, const int &numSteps);
+  // price(option, numSteps) and the derivative of that lattice price in the
+  // volatility, carried through the same backward pass instead of bumping
+  // and repricing. The price is bit-identical to price().
+  static LatticeSensitivity priceWithVega(const AmericanOption &option,
+                                          const int &numSteps);
 
-  static double gamma(const AmericanOption &option, const int &numSteps);
+  template <typename Real>
+  static Real delta(const BasicAmericanOption<Real> &option,
+                    const int &numSteps);
+  template <typename Real>
+  static Real delta(const BasicEuropeanOption<Real> &option,
+                    const int &numSteps);
+  template <typename Real>
+  static Real delta(const BasicBermudanOption<Real> &option,
+                    const int &numSteps);
 
-  static double theta(const AmericanOption &option, const int &numSteps);
+  template <typename Real>
+  static Real gamma(const BasicAmericanOption<Real> &option,
+                    const int &numSteps);
+  template <typename Real>
+  static Real gamma(const BasicEuropeanOption<Real> &option,
+                    const int &numSteps);
+  template <typename Real>
+  static Real gamma(const BasicBermudanOption<Real> &option,
+                    const int &numSteps);
+
+  template <typename Real>
+  static Real theta(const BasicAmericanOption<Real> &option,
+                    const int &numSteps);
+  template <typename Real>
+  static Real theta(const BasicEuropeanOption<Real> &option,
+                    const int &numSteps);
+  template <typename Real>
+  static Real theta(const BasicBermudanOption<Real> &option,
+                    const int &numSteps);
+
+  // Greeks on a yield curve with discrete dividends: bump-and-reprice on the
+  // same curve and schedule. Theta shortens the maturity against the fixed
+  // curve and dividend dates, as the flat-rate theta does with the flat rate.
+  static double delta(const AmericanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double delta(const EuropeanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double delta(const BermudanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+
+  static double gamma(const AmericanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double gamma(const EuropeanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double gamma(const BermudanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+
+  static double theta(const AmericanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double theta(const EuropeanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double theta(const BermudanOption &option, const int &numSteps,
+                      const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
 
 private:
-  static double calculateOptionValue(const double &underlyingPrice,
-                                     const AmericanOption &option);
+  template <typename OptionT>
+  static typename OptionT::value_type
+  priceImpl(const OptionT &option, const int &numSteps,
+            const YieldCurve *curve = nullptr,
+            const DividendSchedule *dividends = nullptr);
+
+  template <typename OptionT>
+  static typename OptionT::value_type
+  priceParallelImpl(const OptionT &option, const int &numSteps,
+                    const unsigned &threads, const WavefrontConfig &config);
+
+  template <typename OptionT>
+  static typename OptionT::value_type
+  deltaImpl(const OptionT &option, const int &numSteps,
+            const YieldCurve *curve = nullptr,
+            const DividendSchedule *dividends = nullptr);
+
+  template <typename OptionT>
+  static typename OptionT::value_type
+  gammaImpl(const OptionT &option, const int &numSteps,
+            const YieldCurve *curve = nullptr,
+            const DividendSchedule *dividends = nullptr);
+
+  template <typename OptionT>
+  static typename OptionT::value_type
+  thetaImpl(const OptionT &option, const int &numSteps,
+            const YieldCurve *curve = nullptr,
+            const DividendSchedule *dividends = nullptr);
 };
 
 #endif // BINOMIAL_TREE_H
\ No newline at end of file
@@ -1,23 +1,86 @@
 #ifndef BLACK_SCHOLES_H
 #define BLACK_SCHOLES_H
 
+#include "market/dividend_schedule.h"
+#include "market/yield_curve.h"
 #include "options/european_option.h"
 
+// Value and first-order Greeks of one contract, as greeksBatch computes them.
+template <typename Real> struct BasicGreeks {
+  Real price;
+  Real delta;
+  Real gamma;
+  Real vega;
+  Real theta;
+  Real rho;
+};
+
+using Greeks = BasicGreeks<double>;
+
+// All formulas are instantiated for float and double; the scalar type is
+// deduced from the option.
 class BlackScholes {
 public:
-  static double price(const EuropeanOption &option);
-  static double delta(const EuropeanOption &option);
-  static double gamma(const EuropeanOption &option);
-  static double vega(const EuropeanOption &option);
-  static double theta(const EuropeanOption &option);
-  static double rho(const EuropeanOption &option);
+  template <typename Real>
+  static Real price(const BasicEuropeanOption<Real> &option);
+  template <typename Real>
+  static Real delta(const BasicEuropeanOption<Real> &option);
+  template <typename Real>
+  static Real gamma(const BasicEuropeanOption<Real> &option);
+  template <typename Real>
+  static Real vega(const BasicEuropeanOption<Real> &option);
+  template <typename Real>
+  static Real theta(const BasicEuropeanOption<Real> &option);
+  template <typename Real>
+  static Real rho(const BasicEuropeanOption<Real> &option);
+
+  // Prices a whole book into prices[0, options.size()). Contracts are not
+  // validated; the loop body is branch-free so it vectorizes when the
+  // toolchain provides vector exp/log (e.g. -ffast-math with libmvec).
+  template <typename Real>
+  static void priceBatch(const std::vector<BasicEuropeanOption<Real>> &options,
+                         Real *prices);
+
+  // Price and Greeks of a whole book into greeks[0, options.size()). d1, d2,
+  // the two discount factors and the density are computed once per contract
+  // and shared by all six outputs, where the per-Greek functions each
+  // recompute them. Contracts are not validated.
+  template <typename Real>
+  static void
+  greeksBatch(const std::vector<BasicEuropeanOption<Real>> &options,
+              BasicGreeks<Real> *greeks);
+
+  // Term-structured rates and escrowed discrete dividends: the option's flat
+  // rate is replaced by the curve's zero rate to expiry and the spot by the
+  // spot less the present value of the dividends paid before expiry.
+  static double price(const EuropeanOption &option, const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double delta(const EuropeanOption &option, const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double gamma(const EuropeanOption &option, const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double vega(const EuropeanOption &option, const YieldCurve &curve,
+                     const DividendSchedule &dividends = {});
+  // theta and rho of the adjusted contract: the zero rate to expiry and the
+  // dividends' present value are held fixed, so rho is the sensitivity to a
+  // parallel shift of the zero curve that leaves the dividend PV unchanged
+  static double theta(const EuropeanOption &option, const YieldCurve &curve,
+                      const DividendSchedule &dividends = {});
+  static double rho(const EuropeanOption &option, const YieldCurve &curve,
+                    const DividendSchedule &dividends = {});
 
 private:
-  static double calculate_d1(const EuropeanOption &option);
-  static double calculate_d2(const EuropeanOption &option);
+  template <typename Real>
+  static Real calculate_d1(const BasicEuropeanOption<Real> &option);
+  template <typename Real>
+  static Real calculate_d2(const BasicEuropeanOption<Real> &option);
+
+  static EuropeanOption
+  adjustForTermStructure(const EuropeanOption &option, const YieldCurve &curve,
+                         const DividendSchedule &dividends);
 
   // cdf of the standard normal distribution
-  static double normal(const double &x);
+  template <typename Real> static Real normal(const Real &x);
 };
 
 #endif // BLACK_SCHOLES_H
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef CHEBYSHEV_PROXY_H
+#define CHEBYSHEV_PROXY_H
+
+#include "options/american_option.h"
+#include <string>
+
+// Region of (S/K, sigma, T) a proxy interpolates over, bounds inclusive
+struct ProxyBox {
+  double moneynessMin;
+  double moneynessMax;
+  double volMin;
+  double volMax;
+  double maturityMin;
+  double maturityMax;
+};
+
+// One tabulated market: contracts with exactly this rate, dividend yield and
+// type are answered from the proxy
+struct ProxyBucket {
+  double riskFreeRate;
+  double dividendYield;
+  OptionType type;
+};
+
+struct ProxyConfig {
+  ProxyBox box;
+  // Chebyshev nodes per dimension, at most ChebyshevProxy::kMaxNodes; a
+  // query costs about two flops per node of the tensor
+  int moneynessNodes = 8;
+  int volNodes = 6;
+  int maturityNodes = 6;
+  // lattice the proxy reproduces and falls back to
+  int numSteps = 500;
+};
+
+// Sum of the magnitudes of the highest-order Chebyshev coefficients along
+// each dimension, an estimate of the worst interpolation error inside the
+// box. Given for a unit strike: price and theta scale with K, gamma with
+// 1 / K.
+struct ProxyErrorEstimate {
+  double price;
+  double delta;
+  double gamma;
+  double theta;
+};
+
+// Tensor Chebyshev interpolant of BinomialTree::price, delta, gamma and theta
+// per bucket. Prices are homogeneous in (S, K), so the tables hold unit
+// strike values in S/K and one bucket serves every strike. Queries outside
+// every bucket's box are priced on the tree.
+class ChebyshevProxy {
+public:
+  static constexpr int kMaxNodes = 64;
+
+  // Tabulates every bucket on up to `threads` threads (0 = all cores).
+  static ChebyshevProxy build(const ProxyConfig &config,
+                              const std::vector<ProxyBucket> &buckets,
+                              const unsigned &threads = 0);
+
+  static ChebyshevProxy load(const std::string &path);
+  void save(const std::string &path) const;
+
+  [[nodiscard]] bool covers(const AmericanOption &option) const;
+
+  [[nodiscard]] double price(const AmericanOption &option) const;
+  [[nodiscard]] double delta(const AmericanOption &option) const;
+  [[nodiscard]] double gamma(const AmericanOption &option) const;
+  [[nodiscard]] double theta(const AmericanOption &option) const;
+
+  [[nodiscard]] ProxyErrorEstimate errorEstimate(const size_t &bucket) const;
+
+  [[nodiscard]] const ProxyConfig &config() const { return config_; }
+  [[nodiscard]] const std::vector<ProxyBucket> &buckets() const {
+    return buckets_;
+  }
+
+private:
+  enum Table { kPrice, kDelta, kGamma, kTheta, kTables };
+
+  ChebyshevProxy(const ProxyConfig &config,
+                 const std::vector<ProxyBucket> &buckets);
+
+  static void validate(const ProxyConfig &config);
+
+  [[nodiscard]] size_t tableSize() const;
+  [[nodiscard]] const double *table(const size_t &bucket,
+                                    const Table &table) const;
+  // index of the bucket whose box holds the option, or buckets_.size()
+  [[nodiscard]] size_t find(const AmericanOption &option) const;
+  // the interpolant of one table at a point inside the box
+  [[nodiscard]] double evaluate(const double *coefficients,
+                                const AmericanOption &option) const;
+
+  ProxyConfig config_;
+  std::vector<ProxyBucket> buckets_;
+  // per bucket and table, indexed (moneyness * volNodes + vol) *
+  // maturityNodes + maturity
+  std::vector<double> coefficients_;
+};
+
+#endif // CHEBYSHEV_PROXY_H
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef HESTON_H
+#define HESTON_H
+
+#include "options/european_option.h"
+#include <complex>
+
+// dv = kappa (theta - v) dt + volOfVol sqrt(v) dW, d<W, Z> = rho dt
+struct HestonParameters {
+  double v0;
+  double kappa;
+  double theta;
+  double volOfVol;
+  double rho;
+};
+
+enum class StripMethod {
+  // Fang-Oosterlee cosine expansion of the density
+  Cos,
+  // Carr-Madan damped call transform on a log-strike grid
+  CarrMadan
+};
+
+struct StripConfig {
+  // COS: series terms and the truncation range in standard deviations
+  int cosTerms = 512;
+  double cosTruncation = 16.0;
+  // Carr-Madan: transform size (a power of two), spacing of the integration
+  // grid and the damping exponent
+  int fftPoints = 4096;
+  double fftSpacing = 0.25;
+  double damping = 1.5;
+};
+
+// European options under the Heston model, priced from the characteristic
+// function of the log price. The option's own volatility is ignored.
+class Heston {
+public:
+  // One contract by Gauss-Legendre integration of Lewis' formula; every
+  // call evaluates the characteristic function afresh.
+  static double price(const EuropeanOption &option,
+                      const HestonParameters &params);
+
+  // A strike strip: contracts sharing spot, rate, dividend yield and
+  // maturity, calls and puts mixed. The characteristic function is
+  // evaluated once for the strip and reused for every strike.
+  static void priceStrip(const std::vector<EuropeanOption> &strip,
+                         const HestonParameters &params, double *prices,
+                         const StripMethod &method = StripMethod::Cos,
+                         const StripConfig &config = {});
+
+  // E[exp(iu (ln(S_T / S_0) - (r - q) T))], in the formulation of
+  // Albrecher et al. that avoids the branch cut of the complex logarithm
+  static std::complex<double>
+  characteristicFunction(const std::complex<double> &u, const double &T,
+                         const HestonParameters &params);
+
+private:
+  static void validate(const EuropeanOption &option);
+  static void validate(const HestonParameters &params);
+};
+
+#endif // HESTON_H
\ No newline at end of file
@@ -1,15 +1,93 @@
 #ifndef IMPLIED_VOL_H
 #define IMPLIED_VOL_H
 
+#include "options/american_option.h"
 #include "options/european_option.h"
 
+enum class ImpliedVolStatus {
+  Converged,
+  // quote at or below the exercise value: no volatility is implied
+  BelowIntrinsic,
+  // quote at or above the underlying (calls) or strike (puts)
+  AboveUpperBound,
+  // the iteration budget ran out before the full lattice converged
+  NotConverged,
+  // a contract field or the quote is not finite, or out of its domain
+  InvalidInput,
+};
+
+// American inversion schedule. Newton steps run on a coarseSteps lattice
+// until a step is below coarseTolerance, then on the full numSteps lattice
+// until a step is below tolerance; both stages are seeded from the
+// Barone-Adesi-Whaley implied volatility.
+struct AmericanImpliedVolConfig {
+  int numSteps = 500;
+  int coarseSteps = 100;
+  double coarseTolerance = 1e-3;
+  double tolerance = 1e-7;
+  // Newton steps on the analytic approximation for the initial guess
+  int guessIterations = 8;
+  // lattice evaluations, both stages together
+  int maxIterations = 30;
+  double minVolatility = 1e-3;
+  double maxVolatility = 5.0;
+};
+
+struct AmericanImpliedVolResult {
+  double volatility;
+  ImpliedVolStatus status;
+  // lattices built, for the cost of the quote
+  int treeEvaluations;
+};
+
 class ImpliedVolatility {
 public:
-  // Calculate implied volatility using Newton-Raphson
+  // Calculate implied volatility using Newton-Raphson. A warm start, e.g.
+  // the last solved volatility of the contract, replaces the cold guess.
   static double calculateImpliedVolatility(const EuropeanOption &option,
                                            const double &marketPrice,
                                            const double &tolerance = 1e-9,
-                                           const int &maxIterations = 1000);
+                                           const int &maxIterations = 1000,
+                                           const double &initialGuess = 0.2);
+
+  // Black-Scholes implied volatilities of a strip of quotes into
+  // vols[0, options.size()); NaN where the contract is invalid, the quote is
+  // outside the no-arbitrage bounds or Newton fails. Each quote is seeded
+  // with its option's volatility, e.g. a warm start from the last surface.
+  // The contract invariants are computed once and the Newton steps of all
+  // quotes run as one sweep per iteration over those not yet converged. A
+  // quote that leaves the positive axis or runs out of iterations restarts
+  // from the Manaster-Koehler point, the inflection of the price in sigma,
+  // from which Newton is monotone.
+  static void impliedVolatilityBatch(const std::vector<EuropeanOption> &options,
+                                     const std::vector<double> &marketPrices,
+                                     double *vols,
+                                     const double &tolerance = 1e-9,
+                                     const int &maxIterations = 100);
+
+  // Volatility at which BinomialTree::price(option, config.numSteps) matches
+  // the quote. Each Newton step takes its slope from
+  // BinomialTree::priceWithVega, one lattice per step; the option's own
+  // volatility seeds the analytic guess. Invalid contracts or quotes and
+  // quotes outside the no-arbitrage bounds are reported through the status,
+  // not thrown; only an invalid config throws.
+  static AmericanImpliedVolResult
+  americanImpliedVolatility(const AmericanOption &option,
+                            const double &marketPrice,
+                            const AmericanImpliedVolConfig &config = {});
+
+  // A whole chain into results[0, options.size()) on up to `threads` threads
+  // (0 picks Parallel::defaultThreadCount()). A bad quote only sets its own
+  // status; the rest of the chain is still solved.
+  static void
+  americanImpliedVolatilityBatch(const std::vector<AmericanOption> &options,
+                                 const std::vector<double> &marketPrices,
+                                 AmericanImpliedVolResult *results,
+                                 const AmericanImpliedVolConfig &config = {},
+                                 const unsigned &threads = 0);
+
+private:
+  static void validate(const AmericanImpliedVolConfig &config);
 };
 
 #endif // IMPLIED_VOL_H
\ No newline at end of file
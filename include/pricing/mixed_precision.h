@@ -0,0 +1,35 @@
+#ifndef MIXED_PRECISION_H
+#define MIXED_PRECISION_H
+
+#include "options/american_option.h"
+#include "options/european_option.h"
+
+struct ScreeningResult {
+  // one price per contract: double for the flagged contracts, the widened
+  // float screening price for the rest
+  std::vector<double> prices;
+  // indices of the contracts re-priced in double, ascending
+  std::vector<size_t> flagged;
+};
+
+// Screens a book with the float engines and re-prices in double only the
+// contracts the caller flags from their float price.
+class MixedPrecision {
+public:
+  // called with (contract index, float price); true re-prices in double
+  using Flag = std::function<bool(const size_t &, const float &)>;
+
+  static EuropeanOptionF toSingle(const EuropeanOption &option);
+  static AmericanOptionF toSingle(const AmericanOption &option);
+
+  static ScreeningResult screen(const std::vector<EuropeanOption> &book,
+                                const Flag &flag);
+
+  // Both passes run on BinomialTree::priceBatch: the whole book in float
+  // lanes, then the flagged contracts in double lanes, which match
+  // BinomialTree::price exactly.
+  static ScreeningResult screen(const std::vector<AmericanOption> &book,
+                                const int &numSteps, const Flag &flag);
+};
+
+#endif // MIXED_PRECISION_H
\ No newline at end of file
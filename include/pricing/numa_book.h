@@ -0,0 +1,52 @@
+#ifndef NUMA_BOOK_H
+#define NUMA_BOOK_H
+
+#include "options/american_option.h"
+#include "options/european_option.h"
+#include "utils/numa.h"
+
+// A book laid out across NUMA nodes for repeated parallel pricing. Every
+// worker of Numa::forEachWorker owns a contiguous slice of the book, so a
+// node's share is proportional to its workers. The worker allocates and
+// first writes its slice and price buffer itself while pinned, which under
+// the kernel's default first-touch policy places their pages in its node's
+// memory, and run() later prices them on the same pinned workers: the hot
+// loop never reads across the interconnect.
+template <typename OptionT> class NumaBook {
+public:
+  // kernel(node, options, prices) fills prices[0, options.size())
+  using Kernel = std::function<void(size_t node,
+                                    const std::vector<OptionT> &options,
+                                    double *prices)>;
+
+  NumaBook(const std::vector<OptionT> &book, const NumaTopology &topology,
+           const unsigned &threadsPerNode = 0);
+
+  // Runs the kernel over every slice on its owning worker, e.g.
+  // BlackScholes::priceBatch or a BinomialTree::priceBatch lambda.
+  void run(const Kernel &kernel);
+
+  // Prices of the last run, in book order
+  void gather(double *prices) const;
+
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] const NumaTopology &topology() const { return topology_; }
+
+private:
+  struct Slice {
+    size_t offset;
+    std::vector<OptionT> options;
+    std::vector<double> prices;
+  };
+
+  [[nodiscard]] size_t workers(const size_t &node) const;
+
+  NumaTopology topology_;
+  unsigned threadsPerNode_;
+  // global index of each node's first worker, then the total
+  std::vector<size_t> firstWorker_;
+  std::vector<Slice> slices_;
+  size_t size_;
+};
+
+#endif // NUMA_BOOK_H
\ No newline at end of file
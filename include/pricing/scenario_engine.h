@@ -0,0 +1,76 @@
+#ifndef SCENARIO_ENGINE_H
+#define SCENARIO_ENGINE_H
+
+#include "options/american_option.h"
+#include "options/european_option.h"
+
+struct ShockGrid {
+  std::vector<double> spotShocks; // relative: S -> S * (1 + shock)
+  std::vector<double> volShocks;  // absolute: sigma -> sigma + shock
+  std::vector<double> rateShocks; // absolute: r -> r + shock
+};
+
+// Dense P&L cube indexed (contract, spot, vol, rate). Spot shocks are the
+// fastest-moving dimension, so the spot row of one (contract, vol, rate) is
+// contiguous.
+class PnlCube {
+public:
+  PnlCube(const size_t &contracts, const ShockGrid &grid);
+
+  [[nodiscard]] double operator()(const size_t &contract, const size_t &spot,
+                                  const size_t &vol, const size_t &rate) const {
+    return values_[offset(contract, vol, rate) + spot];
+  }
+
+  [[nodiscard]] double *spotRow(const size_t &contract, const size_t &vol,
+                                const size_t &rate) {
+    return values_.data() + offset(contract, vol, rate);
+  }
+
+  [[nodiscard]] size_t contracts() const { return contracts_; }
+  [[nodiscard]] size_t spots() const { return spots_; }
+  [[nodiscard]] size_t vols() const { return vols_; }
+  [[nodiscard]] size_t rates() const { return rates_; }
+
+  [[nodiscard]] const std::vector<double> &values() const { return values_; }
+
+private:
+  [[nodiscard]] size_t offset(const size_t &contract, const size_t &vol,
+                              const size_t &rate) const {
+    return ((contract * rates_ + rate) * vols_ + vol) * spots_;
+  }
+
+  size_t contracts_;
+  size_t spots_;
+  size_t vols_;
+  size_t rates_;
+  std::vector<double> values_;
+};
+
+// Re-prices a book under every point of a spot x vol x rate shock grid and
+// returns shocked price minus base price per contract. Work is split into
+// (contract tile, rate shock) items spread across threads (0 = all cores).
+class ScenarioEngine {
+public:
+  // Closed form: the base price, log-moneyness, sqrt(T) and the dividend
+  // discount are hoisted per contract in a first pass, the rate discount per
+  // (contract, rate) and the vol terms per (contract, vol, rate), leaving a
+  // branch-free loop over spot shocks.
+  static PnlCube run(const std::vector<EuropeanOption> &book,
+                     const ShockGrid &grid, const unsigned &threads = 0);
+
+  // Lattice: the vol x spot scenarios of one (contract, rate shock) are
+  // priced together by BinomialTree::priceBatch, kBatchLanes lattices per
+  // induction, and the base price once per contract. Contracts are checked
+  // as BlackScholes::price checks them before any pricing starts.
+  static PnlCube run(const std::vector<AmericanOption> &book,
+                     const ShockGrid &grid, const int &numSteps,
+                     const unsigned &threads = 0);
+
+private:
+  static void validate(const ShockGrid &grid);
+
+  static constexpr size_t kContractTile = 16;
+};
+
+#endif // SCENARIO_ENGINE_H
\ No newline at end of file
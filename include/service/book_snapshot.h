@@ -0,0 +1,87 @@
+#ifndef BOOK_SNAPSHOT_H
+#define BOOK_SNAPSHOT_H
+
+#include "options/american_option.h"
+#include "options/european_option.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// One contract as stored in a snapshot: its terms and the last implied
+// volatility solved for it. Fixed layout, read in place from the mapped
+// file. Derived quantities such as sqrt(T) or e^{-rT} are not stored: the
+// pricers recompute them from the terms anyway, so saving them only made
+// the file larger.
+struct SnapshotRecord {
+  double spotPrice;
+  double strikePrice;
+  double riskFreeRate;
+  double maturity;
+  double volatility;
+  double dividendYield;
+  // NaN when no implied volatility was solved
+  double impliedVolatility;
+  std::int32_t type;          // OptionType
+  std::int32_t exerciseStyle; // ExerciseStyle, European or American
+};
+
+// Read-only view of a snapshot file mapped into memory. The file is a
+// header (magic, format version, record size, record count, a fingerprint of
+// the inputs and a checksum of the records) followed by the records. open()
+// rejects a file whose header or checksum does not match, so a snapshot
+// written by another format version, torn by a crash or taken from other
+// book or market inputs is never restored.
+class BookSnapshot {
+public:
+  // fingerprint of no input bytes
+  static constexpr std::uint64_t kEmptyInputs = 0xcbf29ce484222325ULL;
+
+  static SnapshotRecord record(const EuropeanOption &option,
+                               const double &impliedVolatility);
+  static SnapshotRecord record(const AmericanOption &option,
+                               const double &impliedVolatility);
+
+  // FNV-1a of the bytes the book was loaded from, e.g. the book and market
+  // files; chain several sources by passing the previous result as `seed`.
+  static std::uint64_t fingerprint(const std::string_view &inputs,
+                                   const std::uint64_t &seed = kEmptyInputs);
+
+  // Written to a temporary file next to `path`, synced, renamed over it and
+  // the directory synced, so a reader sees either the previous snapshot or
+  // the complete new one, also after a power loss.
+  static void save(const std::string &path,
+                   const std::vector<SnapshotRecord> &records,
+                   const std::uint64_t &inputs);
+  // Throws std::runtime_error for a corrupt file or one saved with another
+  // inputs fingerprint.
+  static BookSnapshot open(const std::string &path,
+                           const std::uint64_t &inputs);
+
+  BookSnapshot(BookSnapshot &&other) noexcept;
+  BookSnapshot &operator=(BookSnapshot &&other) noexcept;
+  BookSnapshot(const BookSnapshot &) = delete;
+  BookSnapshot &operator=(const BookSnapshot &) = delete;
+  ~BookSnapshot();
+
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] const SnapshotRecord &operator[](const size_t &i) const {
+    return records_[i];
+  }
+
+  // The contract rebuilt with its last implied volatility, when one was
+  // solved, in place of the saved volatility: the warm start for
+  // ImpliedVolatility. Throws std::invalid_argument when the record is of
+  // the other exercise style.
+  [[nodiscard]] EuropeanOption european(const size_t &i) const;
+  [[nodiscard]] AmericanOption american(const size_t &i) const;
+
+private:
+  BookSnapshot(void *mapping, const size_t &mappedBytes);
+
+  void *mapping_;
+  size_t mappedBytes_;
+  const SnapshotRecord *records_;
+  size_t size_;
+};
+
+#endif // BOOK_SNAPSHOT_H
\ No newline at end of file
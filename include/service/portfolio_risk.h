@@ -0,0 +1,73 @@
+#ifndef PORTFOLIO_RISK_H
+#define PORTFOLIO_RISK_H
+
+#include "service/risk_runner.h"
+
+// Bucket edges, ascending: n edges make n + 1 buckets, bucket i holding the
+// values in [edges[i - 1], edges[i]) with the first and last open-ended. No
+// edges means a single bucket.
+struct GreekBuckets {
+  // years to expiry
+  std::vector<double> expiryEdges;
+  // strike over spot
+  std::vector<double> moneynessEdges;
+};
+
+struct PortfolioRiskConfig {
+  // positions per reduction chunk; fixes the order of every sum, so results
+  // depend on it but not on the thread count
+  size_t chunkSize = 1024;
+  // 0 picks Parallel::defaultThreadCount()
+  unsigned threads = 0;
+  // lattice steps for American positions
+  int numSteps = 200;
+};
+
+// Quantity-weighted risk by underlying x expiry bucket x moneyness bucket.
+struct PortfolioRisk {
+  // ascending ids, with the risk of each underlying alongside
+  std::vector<std::uint32_t> underlyings;
+  std::vector<RiskMeasures> byUnderlying;
+  size_t expiryBuckets;
+  size_t moneynessBuckets;
+  // row-major [underlying][expiry][moneyness], underlyings indexed as above
+  std::vector<RiskMeasures> cells;
+  RiskMeasures total;
+
+  [[nodiscard]] const RiskMeasures &cell(const size_t &underlying,
+                                         const size_t &expiry,
+                                         const size_t &moneyness) const {
+    return cells[(underlying * expiryBuckets + expiry) * moneynessBuckets +
+                 moneyness];
+  }
+};
+
+// Book risk aggregated in the pricing pass. The book is cut into fixed
+// chunks; a worker prices a chunk in book order with RiskRunner::measure and
+// keeps one running sum per cell the chunk touches, so a chunk leaves a short
+// list of cell partials instead of per-position results. The partials are
+// added up chunk by chunk, and underlyings and the total from the cells in
+// order: every sum runs in book order within a chunk and in chunk order
+// across them, whatever the thread count.
+class PortfolioAggregator {
+public:
+  static PortfolioRisk
+  aggregate(const std::vector<RiskPosition<EuropeanOption>> &book,
+            const GreekBuckets &buckets,
+            const PortfolioRiskConfig &config = {});
+  static PortfolioRisk
+  aggregate(const std::vector<RiskPosition<AmericanOption>> &book,
+            const GreekBuckets &buckets,
+            const PortfolioRiskConfig &config = {});
+
+private:
+  template <typename OptionT>
+  static PortfolioRisk
+  aggregateImpl(const std::vector<RiskPosition<OptionT>> &book,
+                const GreekBuckets &buckets, const PortfolioRiskConfig &config);
+
+  static void validate(const GreekBuckets &buckets,
+                       const PortfolioRiskConfig &config);
+};
+
+#endif // PORTFOLIO_RISK_H
\ No newline at end of file
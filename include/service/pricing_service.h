@@ -0,0 +1,89 @@
+#ifndef PRICING_SERVICE_H
+#define PRICING_SERVICE_H
+
+#include "options/european_option.h"
+#include "utils/bounded_queue.h"
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+struct PricingServiceConfig {
+  // pending requests before submit() starts applying backpressure
+  size_t queueCapacity = 1 << 16;
+  // largest micro-batch handed to the batch kernel
+  size_t maxBatchSize = 256;
+  // how long the dispatcher keeps coalescing after the first request of a
+  // batch arrives; the latency/throughput knob
+  std::chrono::microseconds maxBatchDelay{20};
+};
+
+struct PricingServiceStats {
+  size_t requests;
+  size_t batches;
+};
+
+// In-process asynchronous Black-Scholes pricing. Producers enqueue requests
+// on a lock-free queue; a single dispatcher thread drains it into
+// micro-batches, prices them with BlackScholes::priceBatch and completes the
+// futures or callbacks. Invalid contracts complete with the exception
+// BlackScholes::price would have thrown.
+class PricingService {
+public:
+  using Callback =
+      std::function<void(const double &price, const std::exception_ptr &error)>;
+
+  explicit PricingService(const PricingServiceConfig &config = {});
+
+  // completes every accepted request, then joins the dispatcher
+  ~PricingService();
+
+  PricingService(const PricingService &) = delete;
+  PricingService &operator=(const PricingService &) = delete;
+
+  // both overloads block (yielding) while the queue is full; callbacks run
+  // on the dispatcher thread and must not throw
+  std::future<double> submit(const EuropeanOption &option);
+  void submit(const EuropeanOption &option, Callback callback);
+
+  [[nodiscard]] PricingServiceStats stats() const;
+
+private:
+  struct Request {
+    EuropeanOption option;
+    std::promise<double> promise;
+    Callback callback;
+  };
+  // requests live on the heap so the ring's cells are one pointer each and
+  // a promise is only created for a request that is actually submitted
+  using RequestPtr = std::unique_ptr<Request>;
+
+  void enqueue(RequestPtr &request);
+  void dispatch();
+  void process(std::vector<RequestPtr> &batch);
+  static void complete(Request &request, const double &price,
+                       const std::exception_ptr &error);
+
+  PricingServiceConfig config_;
+  BoundedQueue<RequestPtr> queue_;
+
+  std::atomic<bool> running_{true};
+  std::atomic<bool> idle_{false};
+  std::mutex wakeMutex_;
+  std::condition_variable wake_;
+
+  std::atomic<size_t> requests_{0};
+  std::atomic<size_t> batches_{0};
+
+  // dispatcher-owned scratch, reused across batches
+  std::vector<EuropeanOption> options_;
+  std::vector<double> prices_;
+  std::vector<size_t> valid_;
+
+  std::thread dispatcher_;
+};
+
+#endif // PRICING_SERVICE_H
\ No newline at end of file
@@ -0,0 +1,193 @@
+#ifndef QUOTE_PIPELINE_H
+#define QUOTE_PIPELINE_H
+
+#include "market/vol_surface.h"
+#include "service/risk_runner.h"
+#include "utils/bounded_queue.h"
+#include "utils/data_parser.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+enum class PipelineStage { Parse, Invert, Fit, Risk };
+
+struct QuotePipelineConfig {
+  // snapshots waiting in front of a stage before the stage feeding it, or
+  // submit(), starts applying backpressure
+  size_t queueCapacity = 64;
+  // thread group of each stage, indexed by PipelineStage
+  std::array<unsigned, 4> threads{1, 2, 1, 1};
+  // Newton inversion of each quote, warm-started from the last surface
+  // fitted for the underlying
+  double ivTolerance = 1e-9;
+  int ivMaxIterations = 100;
+};
+
+struct PipelineStageStats {
+  // snapshots through the stage
+  size_t snapshots;
+  // quotes (parse, invert, fit) or positions (risk) through the stage
+  size_t items;
+  // wall time spent in the stage kernel, summed over its threads
+  std::chrono::nanoseconds busy;
+  // snapshots waiting in front of the stage, now and at the worst
+  size_t queueDepth;
+  size_t peakQueueDepth;
+};
+
+struct QuotePipelineStats {
+  // indexed by PipelineStage
+  std::array<PipelineStageStats, 4> stages;
+  // snapshots completed, with or without an error
+  size_t completed;
+};
+
+struct QuotePipelineResult {
+  // submit() order
+  size_t sequence;
+  std::uint32_t underlying;
+  std::shared_ptr<const VolSurface> surface;
+  // quotes that implied a volatility and quotes dropped for not doing so
+  size_t invertedQuotes;
+  size_t rejectedQuotes;
+  // the book's positions on the underlying, in book order, and their sum
+  std::vector<size_t> positions;
+  std::vector<RiskMeasures> risk;
+  RiskMeasures total;
+  // submit() to risk
+  std::chrono::nanoseconds latency;
+};
+
+// Quote snapshots to book risk as a pipeline: parse the text snapshot, invert
+// every quote to a Black-Scholes implied volatility, fit a VolSurface, then
+// reprice the book's European positions on the underlying with the surface
+// volatility. Inversion, surface forwards and repricing all use the
+// snapshot's spot, rate and dividend yield; a position's own market inputs
+// are ignored. Each stage runs on its own thread group and hands whole
+// snapshots to the next one through a bounded lock-free queue, so parsing,
+// inversion and repricing of consecutive snapshots overlap and the
+// throughput is that of the slowest stage. A stage that finds the next queue
+// full waits (yielding), which throttles the stages upstream and in the end
+// submit().
+//
+// When a stage has several threads, snapshots may complete out of
+// submission order, also two snapshots of the same underlying; the result's
+// sequence restores the order. The surface kept per underlying for warm
+// starts is still that of the latest-submitted snapshot fitted so far: a
+// snapshot overtaken by a later one of its underlying does not replace the
+// later one's surface. A snapshot that fails a stage completes with the
+// exception, and skips the rest of the pipeline.
+class QuotePipeline {
+public:
+  // called on the thread of the stage that finished the snapshot; must be
+  // thread-safe and must not throw. The result holds the sequence (and the
+  // underlying, once parsed) when error is set.
+  using Callback = std::function<void(const QuotePipelineResult &result,
+                                      const std::exception_ptr &error)>;
+
+  QuotePipeline(const std::vector<RiskPosition<EuropeanOption>> &book,
+                Callback callback, const QuotePipelineConfig &config = {});
+
+  // completes every accepted snapshot, then joins the stages
+  ~QuotePipeline();
+
+  QuotePipeline(const QuotePipeline &) = delete;
+  QuotePipeline &operator=(const QuotePipeline &) = delete;
+
+  // queues a text snapshot (see DataParser) and returns its sequence number;
+  // blocks (yielding) while the parse queue is full
+  size_t submit(std::string snapshot);
+
+  // blocks until every snapshot submitted so far has completed
+  void drain();
+
+  [[nodiscard]] QuotePipelineStats stats() const;
+
+  // The same stages run one after another on the calling thread, one
+  // snapshot at a time: the batch flow the pipeline replaces. Results are
+  // in input order; a failed snapshot throws.
+  static std::vector<QuotePipelineResult>
+  runSerial(const std::vector<RiskPosition<EuropeanOption>> &book,
+            const std::vector<std::string> &snapshots,
+            const QuotePipelineConfig &config = {});
+
+private:
+  static constexpr size_t kStages = 4;
+
+  struct Work {
+    QuotePipelineResult result{};
+    std::chrono::steady_clock::time_point submitted;
+    std::string text;
+    QuoteSnapshot snapshot{};
+    // per quote, NaN where no volatility was implied
+    std::vector<double> vols;
+  };
+
+  struct StageCounters {
+    std::atomic<size_t> snapshots{0};
+    std::atomic<size_t> items{0};
+    std::atomic<long long> busyNanos{0};
+    std::atomic<size_t> peakQueueDepth{0};
+    // workers still running; the last one out closes the next queue
+    std::atomic<unsigned> running{0};
+    std::atomic<bool> closed{false};
+  };
+
+  struct PublishedSurface {
+    // submit() order of the snapshot it was fitted to
+    size_t sequence;
+    std::shared_ptr<const VolSurface> surface;
+  };
+
+  // state the stage kernels share with runSerial
+  struct Context {
+    Context(const std::vector<RiskPosition<EuropeanOption>> &book,
+            const QuotePipelineConfig &config);
+
+    // null until a snapshot of the underlying has been fitted
+    [[nodiscard]] std::shared_ptr<const VolSurface>
+    latestSurface(const std::uint32_t &underlying) const;
+    // kept only if no later snapshot of the underlying was published first
+    void publish(const std::uint32_t &underlying, const size_t &sequence,
+                 const std::shared_ptr<const VolSurface> &surface);
+
+    std::vector<RiskPosition<EuropeanOption>> book;
+    QuotePipelineConfig config;
+    // book indices by underlying
+    std::unordered_map<std::uint32_t, std::vector<size_t>> positions;
+    mutable std::mutex surfacesMutex;
+    std::unordered_map<std::uint32_t, PublishedSurface> surfaces;
+  };
+
+  // the stage kernels; each returns the items it processed
+  static size_t parse(Context &context, Work &work);
+  static size_t invert(Context &context, Work &work);
+  static size_t fit(Context &context, Work &work);
+  static size_t risk(Context &context, Work &work);
+  static size_t process(const size_t &stage, Context &context, Work &work);
+
+  static void validate(const QuotePipelineConfig &config);
+
+  void runStage(const size_t &stage);
+  void push(const size_t &stage, Work &work);
+  void complete(Work &work, const std::exception_ptr &error);
+
+  Context context_;
+  Callback callback_;
+  std::array<std::unique_ptr<BoundedQueue<Work>>, kStages> queues_;
+  std::array<StageCounters, kStages> counters_;
+
+  std::atomic<size_t> submitted_{0};
+  std::atomic<size_t> completed_{0};
+  std::mutex drainMutex_;
+  std::condition_variable drained_;
+
+  std::vector<std::thread> threads_;
+};
+
+#endif // QUOTE_PIPELINE_H
\ No newline at end of file
@@ -0,0 +1,110 @@
+#ifndef RISK_RUNNER_H
+#define RISK_RUNNER_H
+
+#include "options/american_option.h"
+#include "options/european_option.h"
+#include <chrono>
+#include <cstdint>
+
+// A holding of `quantity` contracts on the underlying identified by
+// `underlying`; the book is sharded by that id.
+template <typename OptionT> struct RiskPosition {
+  std::uint32_t underlying;
+  double quantity;
+  OptionT option;
+};
+
+// Value and first-order risk, quantity-weighted when reported per position.
+struct RiskMeasures {
+  double price;
+  double delta;
+  double gamma;
+  double vega;
+  double theta;
+  double rho;
+};
+
+// Field-wise sum; every risk reduction adds measures this way.
+inline RiskMeasures &operator+=(RiskMeasures &sum, const RiskMeasures &risk) {
+  sum.price += risk.price;
+  sum.delta += risk.delta;
+  sum.gamma += risk.gamma;
+  sum.vega += risk.vega;
+  sum.theta += risk.theta;
+  sum.rho += risk.rho;
+  return sum;
+}
+
+struct RiskRunnerConfig {
+  // worker processes running at once
+  unsigned workers = 4;
+  // shards per worker: finer shards cost more forks but make a rerun redo
+  // less work
+  unsigned shardsPerWorker = 4;
+  // a shard still running after this long is killed and rerun
+  std::chrono::milliseconds shardTimeout{600000};
+  // runs of one shard before the whole run fails
+  int maxAttempts = 3;
+  // lattice steps for American positions
+  int numSteps = 200;
+  // called in the worker before it prices a shard, with the shard index and
+  // the attempt number; lets tests inject crashes and stalls
+  std::function<void(size_t shard, int attempt)> shardHook;
+};
+
+struct RiskReport {
+  // in book order
+  std::vector<RiskMeasures> positions;
+  // ascending ids, with the risk of each underlying alongside
+  std::vector<std::uint32_t> underlyings;
+  std::vector<RiskMeasures> byUnderlying;
+  RiskMeasures total;
+  // book indices, ascending, of the positions whose pricing threw, e.g. an
+  // invalid contract; their risk is zero and adds nothing to the sums, and
+  // measure() on the contract reproduces the error
+  std::vector<size_t> failed;
+  // shard runs beyond the first, after a crash or timeout
+  size_t reruns;
+};
+
+// Overnight risk across worker processes on one host. Positions are grouped
+// by underlying and each shard, a run of whole underlyings, is priced by a
+// forked worker that writes its positions' risk into a results region
+// shared with the coordinator. A pricing error is deterministic, so the
+// worker records it for that position in the shared region and carries on.
+// A worker that crashes or overruns shardTimeout is rerun for its shard
+// alone; the rest of the results stay in place. The coordinator then
+// reduces positions to underlyings in parallel, each underlying summed in
+// book order, so the report does not depend on scheduling. European
+// positions use BlackScholes, American ones BinomialTree (rho by a 1bp rate
+// bump).
+//
+// The workers are fork()ed without exec, and a forked child has only the
+// calling thread: a lock another thread held at the fork, e.g. inside
+// malloc, is never released in the child. Call run() while the process is
+// single-threaded, before starting a PricingService, QuotePipeline or any
+// other threads.
+class RiskRunner {
+public:
+  static RiskReport run(const std::vector<RiskPosition<EuropeanOption>> &book,
+                        const RiskRunnerConfig &config = {});
+  static RiskReport run(const std::vector<RiskPosition<AmericanOption>> &book,
+                        const RiskRunnerConfig &config = {});
+
+  // Unweighted risk of one contract as the runner prices it; numSteps is
+  // ignored for European contracts. Both overloads reject the contracts
+  // BlackScholes::price rejects.
+  static RiskMeasures measure(const EuropeanOption &option,
+                              const int &numSteps);
+  static RiskMeasures measure(const AmericanOption &option,
+                              const int &numSteps);
+
+private:
+  template <typename OptionT>
+  static RiskReport runImpl(const std::vector<RiskPosition<OptionT>> &book,
+                            const RiskRunnerConfig &config);
+
+  static void validate(const RiskRunnerConfig &config);
+};
+
+#endif // RISK_RUNNER_H
\ No newline at end of file
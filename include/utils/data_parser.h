@@ -0,0 +1,47 @@
+#ifndef DATA_PARSER_H
+#define DATA_PARSER_H
+
+#include "options/option.h"
+#include <common.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// A listed option quote: contract terms and the mid price.
+struct OptionQuote {
+  OptionType type;
+  double strike;
+  double maturity;
+  double price;
+};
+
+// Every quote of one underlying at one instant, with the spot, the flat rate
+// and the continuous dividend yield they were struck against.
+struct QuoteSnapshot {
+  std::uint32_t underlying;
+  double spot;
+  double rate;
+  double dividendYield;
+  std::vector<OptionQuote> quotes;
+};
+
+// Text quote feeds. A snapshot is a header line
+// "underlying,spot,rate[,dividendYield]" (no yield means zero) followed by
+// one "C|P,strike,maturity,price" line per quote; blank lines and lines
+// starting with '#' are skipped. Malformed input throws
+// std::invalid_argument.
+class DataParser {
+public:
+  static QuoteSnapshot parseSnapshot(const std::string_view &text);
+
+  static OptionQuote parseQuote(const std::string_view &line);
+
+private:
+  // splits line on ',' into exactly fields.size() fields
+  static bool split(const std::string_view &line,
+                    std::vector<std::string_view> &fields);
+
+  static bool parseNumber(const std::string_view &field, double &value);
+};
+
+#endif // DATA_PARSER_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <common.h>
+#include <string>
+
+struct NumaNode {
+  int id;
+  std::vector<int> cpus;
+};
+
+// The nodes work is scheduled over. Discovered from sysfs by default, but a
+// plain aggregate, so a deployment can pin to a subset of nodes or cores, or
+// a test can describe a machine it does not run on.
+struct NumaTopology {
+  std::vector<NumaNode> nodes;
+};
+
+class Numa {
+public:
+  // Nodes listed in <root>/online with their <root>/node<id>/cpulist;
+  // memory-only nodes are skipped. Without the sysfs directory (non-NUMA
+  // kernels) the result is one node holding CPUs [0, hardware concurrency).
+  static NumaTopology
+  discover(const std::string &root = "/sys/devices/system/node");
+
+  // Kernel cpulist syntax: "0-3,8,10-11"
+  static std::vector<int> parseCpuList(const std::string &list);
+
+  // Binds the calling thread to one CPU; false when the kernel refuses (a
+  // CPU outside the process's cgroup or affinity mask), in which case the
+  // thread keeps running unpinned.
+  static bool pinCurrentThread(const int &cpu);
+
+  // Calls body(node, worker, workers) for every worker of every node, each
+  // on its own thread pinned to a CPU of its node, and joins them; a node
+  // runs threadsPerNode workers, or one per CPU when 0. The first exception
+  // thrown by body is rethrown once every worker has stopped.
+  static void forEachWorker(
+      const NumaTopology &topology,
+      const std::function<void(size_t node, size_t worker, size_t workers)>
+          &body,
+      const unsigned &threadsPerNode = 0);
+
+  static void validate(const NumaTopology &topology);
+};
+
+#endif // NUMA_H
\ No newline at end of file
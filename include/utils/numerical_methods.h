@@ -2,6 +2,14 @@
 #define NUMERICAL_METHODS_H
 
 #include <common.h>
+#include <cmath>
+#include <complex>
+
+// n-point rule on [-1, 1]
+struct QuadratureRule {
+  std::vector<double> nodes;
+  std::vector<double> weights;
+};
 
 class NumericalMethods {
 public:
@@ -10,6 +18,41 @@ public:
                               const std::function<double(double)> &fprime,
                               double initialGuess, double tolerance = 1e-9,
                               int maxIterations = 1000);
+
+  // cdf of the standard normal distribution (Abramowitz-Stegun 26.2.17,
+  // |error| < 7.5e-8). Header-inline so batch kernels can vectorize it.
+  template <typename Real> static Real normalCdf(const Real &x) {
+    constexpr Real a1 = Real(0.31938153);
+    constexpr Real a2 = Real(-0.356563782);
+    constexpr Real a3 = Real(1.781477937);
+    constexpr Real a4 = Real(-1.821255978);
+    constexpr Real a5 = Real(1.330274429);
+
+    const Real k = Real(1) / (Real(1) + Real(0.2316419) * std::abs(x));
+    const Real cnd = normalPdf(x) * k *
+                     (a1 + k * (a2 + k * (a3 + k * (a4 + k * a5))));
+
+    return x >= Real(0) ? Real(1) - cnd : cnd;
+  }
+
+  // P(X <= x, Y <= y) for standard normals with correlation rho (Genz 2004,
+  // double precision accuracy)
+  static double bivariateNormalCdf(const double &x, const double &y,
+                                   const double &rho);
+
+  // Gauss-Legendre nodes and weights, by Newton iteration on P_n
+  static QuadratureRule gaussLegendre(const int &n);
+
+  // In-place radix-2 transform X_k = sum_j x_j e^{-2 pi i jk / n}; the size
+  // must be a power of two
+  static void fft(std::vector<std::complex<double>> &data);
+
+  // pdf of the standard normal distribution
+  template <typename Real> static Real normalPdf(const Real &x) {
+    constexpr Real one_over_sqrt_two_pi =
+        Real(0.39894228040143267793994605993438);
+    return one_over_sqrt_two_pi * std::exp(-x * x / Real(2));
+  }
 };
 
 #endif // NUMERICAL_METHODS_H
\ No newline at end of file
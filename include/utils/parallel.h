@@ -0,0 +1,43 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <common.h>
+#include <condition_variable>
+#include <mutex>
+
+class Parallel {
+public:
+  // std::thread::hardware_concurrency(), at least 1
+  static unsigned defaultThreadCount();
+
+  // Calls body(i) for every i in [0, count) on up to `threads` threads
+  // (0 picks defaultThreadCount()). Items are claimed in increasing order
+  // from a shared counter; the first exception thrown by body is rethrown on
+  // the calling thread once every worker has stopped.
+  static void forEach(const size_t &count,
+                      const std::function<void(size_t)> &body,
+                      const unsigned &threads = 0);
+};
+
+// Reusable rendezvous for a fixed set of threads (std::barrier is C++20).
+// arriveAndWait() returns once all `count` threads of the current phase have
+// arrived; writes made before arriving are visible to every thread after it
+// returns.
+class Barrier {
+public:
+  explicit Barrier(const size_t &count);
+
+  Barrier(const Barrier &) = delete;
+  Barrier &operator=(const Barrier &) = delete;
+
+  void arriveAndWait();
+
+private:
+  const size_t count_;
+  size_t waiting_ = 0;
+  size_t phase_ = 0;
+  std::mutex mutex_;
+  std::condition_variable released_;
+};
+
+#endif // PARALLEL_H
\ No newline at end of file
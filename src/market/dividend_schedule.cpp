@@ -0,0 +1,66 @@
+#include "market/dividend_schedule.h"
+#include "error_messages.h"
+#include <stdexcept>
+
+DividendSchedule::DividendSchedule(std::vector<Dividend> dividends)
+    : dividends_(std::move(dividends)) {
+  for (const Dividend &dividend : dividends_) {
+    if (dividend.time < 0.0 || dividend.amount < 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::TermStructure::kInvalidDividend);
+    }
+  }
+  std::sort(dividends_.begin(), dividends_.end(),
+            [](const Dividend &a, const Dividend &b) {
+              return a.time < b.time;
+            });
+}
+
+double DividendSchedule::presentValue(const YieldCurve &curve,
+                                      const double &from,
+                                      const double &to) const {
+  double pv = 0.0;
+  for (const Dividend &dividend : dividends_) {
+    if (dividend.time > from && dividend.time <= to) {
+      pv += dividend.amount * curve.discount(dividend.time);
+    }
+  }
+  return pv;
+}
+
+std::vector<double>
+DividendSchedule::remainingValueTable(const YieldCurve &curve, const double &T,
+                                      const int &numSteps) const {
+  if (dividends_.empty()) {
+    return std::vector<double>(numSteps + 1, 0.0);
+  }
+  return remainingValueTable(curve, T, curve.discountTable(T, numSteps));
+}
+
+std::vector<double> DividendSchedule::remainingValueTable(
+    const YieldCurve &curve, const double &T,
+    const std::vector<double> &discounts) const {
+  const int numSteps = static_cast<int>(discounts.size()) - 1;
+  std::vector<double> table(numSteps + 1, 0.0);
+  if (dividends_.empty()) {
+    return table;
+  }
+
+  const double dt = T / numSteps;
+
+  // walk backwards so each step only adds the dividends paid in its interval
+  double pvToday = 0.0;
+  auto it = std::upper_bound(dividends_.begin(), dividends_.end(), T,
+                             [](const double &t, const Dividend &dividend) {
+                               return t < dividend.time;
+                             });
+  for (int i = numSteps; i >= 0; --i) {
+    const double t = i * dt;
+    while (it != dividends_.begin() && std::prev(it)->time > t) {
+      --it;
+      pvToday += it->amount * curve.discount(it->time);
+    }
+    table[i] = pvToday / discounts[i];
+  }
+  return table;
+}
\ No newline at end of file
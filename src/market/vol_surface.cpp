@@ -0,0 +1,157 @@
+#include "market/vol_surface.h"
+#include "error_messages.h"
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+  // keeps a smile extrapolated past its data from going through zero
+  constexpr double kMinVolatility = 1e-4;
+
+  // Gaussian elimination with partial pivoting on the n x n normal equations
+  // held in m (right-hand side in column n); false when they are singular
+  bool solve(std::array<std::array<double, 4>, 3> m, const int &n,
+             double *x) {
+    for (int col = 0; col < n; ++col) {
+      int pivot = col;
+      for (int row = col + 1; row < n; ++row) {
+        if (std::abs(m[row][col]) > std::abs(m[pivot][col])) {
+          pivot = row;
+        }
+      }
+      if (std::abs(m[pivot][col]) < 1e-14 * std::abs(m[0][0])) {
+        return false;
+      }
+      std::swap(m[col], m[pivot]);
+      for (int row = col + 1; row < n; ++row) {
+        const double factor = m[row][col] / m[col][col];
+        for (int j = col; j <= n; ++j) {
+          m[row][j] -= factor * m[col][j];
+        }
+      }
+    }
+    for (int row = n - 1; row >= 0; --row) {
+      double sum = m[row][n];
+      for (int j = row + 1; j < n; ++j) {
+        sum -= m[row][j] * x[j];
+      }
+      x[row] = sum / m[row][row];
+    }
+    return true;
+  }
+
+} // namespace
+
+VolSurface::VolSurface(const double &spot, const double &rate,
+                       const std::vector<double> &strikes,
+                       const std::vector<double> &maturities,
+                       const std::vector<double> &vols,
+                       const double &dividendYield)
+    : spot_(spot), rate_(rate), dividendYield_(dividendYield) {
+  if (strikes.empty() || strikes.size() != maturities.size() ||
+      strikes.size() != vols.size()) {
+    throw std::invalid_argument(
+        ErrorMessages::Surface::kMismatchedSurfaceData);
+  }
+  if (!(spot > 0.0)) {
+    throw std::invalid_argument(ErrorMessages::BlackScholes::kInvalidSpotPrice);
+  }
+  for (size_t i = 0; i < strikes.size(); ++i) {
+    if (!(strikes[i] > 0.0 && maturities[i] > 0.0 && vols[i] > 0.0)) {
+      throw std::invalid_argument(
+          ErrorMessages::Surface::kInvalidSurfacePoint);
+    }
+  }
+
+  std::vector<size_t> order(strikes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t l, size_t r) {
+    return maturities[l] < maturities[r];
+  });
+
+  std::vector<double> k;
+  std::vector<double> smileVols;
+  for (size_t first = 0; first < order.size();) {
+    const double T = maturities[order[first]];
+    const double forward = spot_ * std::exp((rate_ - dividendYield_) * T);
+    k.clear();
+    smileVols.clear();
+    size_t last = first;
+    for (; last < order.size() && maturities[order[last]] == T; ++last) {
+      k.push_back(std::log(strikes[order[last]] / forward));
+      smileVols.push_back(vols[order[last]]);
+    }
+    expiries_.push_back(T);
+    smiles_.push_back(fitSmile(k, smileVols));
+    first = last;
+  }
+}
+
+VolSurface::Smile VolSurface::fitSmile(const std::vector<double> &k,
+                                       const std::vector<double> &vols) {
+  Smile smile{0.0, 0.0, 0.0, *std::min_element(k.begin(), k.end()),
+              *std::max_element(k.begin(), k.end())};
+
+  // normal equations of the quadratic; coincident strikes drop the degree
+  std::array<double, 5> moments{};
+  std::array<double, 3> rhs{};
+  for (size_t i = 0; i < k.size(); ++i) {
+    double power = 1.0;
+    for (int p = 0; p < 5; ++p) {
+      if (p < 3) {
+        rhs[p] += power * vols[i];
+      }
+      moments[p] += power;
+      power *= k[i];
+    }
+  }
+  for (int n = 3; n > 0; --n) {
+    std::array<std::array<double, 4>, 3> m{};
+    for (int row = 0; row < n; ++row) {
+      for (int col = 0; col < n; ++col) {
+        m[row][col] = moments[row + col];
+      }
+      m[row][n] = rhs[row];
+    }
+    std::array<double, 3> coefficients{};
+    if (solve(m, n, coefficients.data())) {
+      smile.a = coefficients[0];
+      smile.b = coefficients[1];
+      smile.c = coefficients[2];
+      break;
+    }
+  }
+  return smile;
+}
+
+double VolSurface::smileVolatility(const size_t &expiry,
+                                   const double &strike) const {
+  const Smile &smile = smiles_[expiry];
+  const double forward =
+      spot_ * std::exp((rate_ - dividendYield_) * expiries_[expiry]);
+  const double k =
+      std::clamp(std::log(strike / forward), smile.kMin, smile.kMax);
+  return std::max(smile.a + k * (smile.b + k * smile.c), kMinVolatility);
+}
+
+double VolSurface::volatility(const double &strike,
+                              const double &maturity) const {
+  const auto it =
+      std::upper_bound(expiries_.begin(), expiries_.end(), maturity);
+  if (it == expiries_.begin()) {
+    return smileVolatility(0, strike);
+  }
+  if (it == expiries_.end()) {
+    return smileVolatility(expiries_.size() - 1, strike);
+  }
+  const size_t upper = it - expiries_.begin();
+  const double t0 = expiries_[upper - 1];
+  const double t1 = expiries_[upper];
+  const double v0 = smileVolatility(upper - 1, strike);
+  const double v1 = smileVolatility(upper, strike);
+  const double w0 = v0 * v0 * t0;
+  const double w1 = v1 * v1 * t1;
+  const double w = w0 + (w1 - w0) * (maturity - t0) / (t1 - t0);
+  return std::sqrt(w / maturity);
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "market/yield_curve.h"
+#include "error_messages.h"
+#include <cmath>
+#include <stdexcept>
+
+YieldCurve::YieldCurve(const std::vector<double> &times,
+                       const std::vector<double> &zero_rates) {
+  if (times.empty() || times.size() != zero_rates.size()) {
+    throw std::invalid_argument(
+        ErrorMessages::TermStructure::kMismatchedCurveData);
+  }
+
+  times_.reserve(times.size() + 1);
+  log_discounts_.reserve(times.size() + 1);
+  times_.push_back(0.0);
+  log_discounts_.push_back(0.0);
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (times[i] <= times_.back()) {
+      throw std::invalid_argument(
+          ErrorMessages::TermStructure::kInvalidCurvePillars);
+    }
+    times_.push_back(times[i]);
+    log_discounts_.push_back(-zero_rates[i] * times[i]);
+  }
+}
+
+YieldCurve YieldCurve::flat(const double &rate) { return {{1.0}, {rate}}; }
+
+double YieldCurve::logDiscount(const double &t, const size_t &segment) const {
+  // segment is the index of the last pillar at or before t, capped so that
+  // [segment, segment + 1] is a valid interval for extrapolation
+  const double t0 = times_[segment];
+  const double t1 = times_[segment + 1];
+  const double w = (t - t0) / (t1 - t0);
+  return log_discounts_[segment] +
+         w * (log_discounts_[segment + 1] - log_discounts_[segment]);
+}
+
+double YieldCurve::discount(const double &t) const {
+  if (t <= 0.0) {
+    return 1.0;
+  }
+  const auto it = std::upper_bound(times_.begin(), times_.end(), t);
+  const size_t segment =
+      std::min<size_t>(it - times_.begin() - 1, times_.size() - 2);
+  return std::exp(logDiscount(t, segment));
+}
+
+double YieldCurve::zeroRate(const double &t) const {
+  if (t <= 0.0) {
+    // instantaneous short rate
+    return -log_discounts_[1] / times_[1];
+  }
+  return -std::log(discount(t)) / t;
+}
+
+double YieldCurve::forwardRate(const double &t1, const double &t2) const {
+  return std::log(discount(t1) / discount(t2)) / (t2 - t1);
+}
+
+std::vector<double> YieldCurve::discountTable(const double &T,
+                                              const int &numSteps) const {
+  std::vector<double> table(numSteps + 1);
+  const double dt = T / numSteps;
+  size_t segment = 0;
+  for (int i = 0; i <= numSteps; ++i) {
+    const double t = i * dt;
+    while (segment + 2 < times_.size() && times_[segment + 1] <= t) {
+      ++segment;
+    }
+    table[i] = std::exp(logDiscount(t, segment));
+  }
+  return table;
+}
\ No newline at end of file
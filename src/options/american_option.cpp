@@ -1,18 +1,22 @@
 #include "options/american_option.h"
 #include <cmath>
 
-AmericanOption::AmericanOption(const double &spot_price,
-                               const double &strike_price,
-                               const double &risk_free_rate,
-                               const double &time_to_maturity,
-                               const double &sigma, const OptionType &type,
-                               const double &dividend_yield)
-    : Option<AmericanOption>(spot_price, strike_price, risk_free_rate,
-                             time_to_maturity, sigma, type, dividend_yield) {}
+template <typename Real>
+BasicAmericanOption<Real>::BasicAmericanOption(
+    const Real &spot_price, const Real &strike_price,
+    const Real &risk_free_rate, const Real &time_to_maturity, const Real &sigma,
+    const OptionType &type, const Real &dividend_yield)
+    : Option<BasicAmericanOption<Real>, Real>(
+          spot_price, strike_price, risk_free_rate, time_to_maturity, sigma,
+          type, dividend_yield) {}
 
-double AmericanOption::payoffImpl(const double &underlying_price) const {
-  if (type_ == OptionType::Call) {
-    return std::max(0.0, underlying_price - strike_price_);
+template <typename Real>
+Real BasicAmericanOption<Real>::payoffImpl(const Real &underlying_price) const {
+  if (this->type_ == OptionType::Call) {
+    return std::max(Real(0), underlying_price - this->strike_price_);
   }
-  return std::max(0.0, strike_price_ - underlying_price);
-}
\ No newline at end of file
+  return std::max(Real(0), this->strike_price_ - underlying_price);
+}
+
+template class BasicAmericanOption<float>;
+template class BasicAmericanOption<double>;
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "options/bermudan_option.h"
+#include <cmath>
+
+template <typename Real>
+BasicBermudanOption<Real>::BasicBermudanOption(
+    const Real &spot_price, const Real &strike_price,
+    const Real &risk_free_rate, const Real &time_to_maturity, const Real &sigma,
+    const OptionType &type, std::vector<Real> exercise_times,
+    const Real &dividend_yield)
+    : Option<BasicBermudanOption<Real>, Real>(
+          spot_price, strike_price, risk_free_rate, time_to_maturity, sigma,
+          type, dividend_yield),
+      exercise_times_(std::move(exercise_times)) {
+  std::sort(exercise_times_.begin(), exercise_times_.end());
+}
+
+template <typename Real>
+Real BasicBermudanOption<Real>::payoffImpl(const Real &underlying_price) const {
+  if (this->type_ == OptionType::Call) {
+    return std::max(Real(0), underlying_price - this->strike_price_);
+  }
+  return std::max(Real(0), this->strike_price_ - underlying_price);
+}
+
+template class BasicBermudanOption<float>;
+template class BasicBermudanOption<double>;
\ No newline at end of file
@@ -1,20 +1,27 @@
 #include "options/european_option.h"
 #include <cmath>
 
-EuropeanOption::EuropeanOption(const double &spot_price,
-                               const double &strike_price,
-                               const double &risk_free_rate,
-                               const double &time_to_maturity,
-                               const double &sigma, const OptionType &type,
-                               const double &dividend_yield)
-    : Option<EuropeanOption>(spot_price, strike_price, risk_free_rate,
-                             time_to_maturity, sigma, type, dividend_yield) {}
+template <typename Real>
+BasicEuropeanOption<Real>::BasicEuropeanOption(
+    const Real &spot_price, const Real &strike_price,
+    const Real &risk_free_rate, const Real &time_to_maturity, const Real &sigma,
+    const OptionType &type, const Real &dividend_yield)
+    : Option<BasicEuropeanOption<Real>, Real>(
+          spot_price, strike_price, risk_free_rate, time_to_maturity, sigma,
+          type, dividend_yield) {}
 
-double EuropeanOption::payoffImpl(const double &underlying_price) const {
-  if (type_ == OptionType::Call) {
-    return std::max(0.0, underlying_price - strike_price_);
+template <typename Real>
+Real BasicEuropeanOption<Real>::payoffImpl(const Real &underlying_price) const {
+  if (this->type_ == OptionType::Call) {
+    return std::max(Real(0), underlying_price - this->strike_price_);
   }
-  return std::max(0.0, strike_price_ - underlying_price);
+  return std::max(Real(0), this->strike_price_ - underlying_price);
 }
 
-void EuropeanOption::setVolatilityImpl(const double &sigma) { sigma_ = sigma; }
\ No newline at end of file
+template <typename Real>
+void BasicEuropeanOption<Real>::setVolatilityImpl(const Real &sigma) {
+  this->sigma_ = sigma;
+}
+
+template class BasicEuropeanOption<float>;
+template class BasicEuropeanOption<double>;
\ No newline at end of file
@@ -0,0 +1,496 @@
+#include "pricing/analytic_american.h"
+#include "error_messages.h"
+#include "utils/numerical_methods.h"
+#include "utils/parallel.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+  constexpr double kPi = 3.14159265358979323846;
+  constexpr int kMaxCriticalPriceIterations = 100;
+  constexpr double kCriticalPriceTolerance = 1e-9;
+
+  // plain contract data; the approximations work on these so put-call
+  // symmetry is a swap of fields rather than a new option
+  struct Contract {
+    double S;
+    double K;
+    double r;
+    double q;
+    double sigma;
+    double T;
+  };
+
+  Contract toContract(const AmericanOption &option) {
+    return {option.getSpotPrice(), option.getStrikePrice(),
+            option.getRiskFreeRate(), option.getDividendYield(),
+            option.getVolatility(), option.getMaturity()};
+  }
+
+  // C(S, K, r, q) = P(K, S, q, r) (McDonald-Schroder), for both exercise
+  // styles
+  Contract symmetric(const Contract &c) {
+    return {c.K, c.S, c.q, c.r, c.sigma, c.T};
+  }
+
+  // the A-S approximation in NumericalMethods::normalCdf is only good to
+  // ~1e-7, too coarse for the critical price iterations
+  double cdf(const double &x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); }
+
+  double pdf(const double &x) { return NumericalMethods::normalPdf(x); }
+
+  double dPlus(const Contract &c, const double &tau, const double &moneyness) {
+    return (std::log(moneyness) + (c.r - c.q + 0.5 * c.sigma * c.sigma) * tau) /
+           (c.sigma * std::sqrt(tau));
+  }
+
+  double european(const Contract &c, const double &spot, const bool &call) {
+    const double d1 = dPlus(c, c.T, spot / c.K);
+    const double d2 = d1 - c.sigma * std::sqrt(c.T);
+    const double dq = std::exp(-c.q * c.T);
+    const double dr = std::exp(-c.r * c.T);
+    return call ? spot * dq * cdf(d1) - c.K * dr * cdf(d2)
+                : c.K * dr * cdf(-d2) - spot * dq * cdf(-d1);
+  }
+
+  // 2r / (sigma^2 (1 - e^{-rT})), continuous at r = 0
+  double rateOverHorizon(const Contract &c) {
+    const double v2 = c.sigma * c.sigma;
+    return c.r == 0.0 ? 2.0 / (v2 * c.T)
+                      : 2.0 * c.r / (v2 * -std::expm1(-c.r * c.T));
+  }
+
+  // --- Barone-Adesi-Whaley ------------------------------------------------
+
+  // Critical spot above which the call is exercised, by the Newton iteration
+  // of Barone-Adesi and Whaley seeded with their perpetual-boundary guess
+  double bawCriticalCall(const Contract &c) {
+    const double b = c.r - c.q;
+    const double v2 = c.sigma * c.sigma;
+    const double sqrtT = std::sqrt(c.T);
+    const double n = 2.0 * b / v2;
+    const double m = 2.0 * c.r / v2;
+    const double qInf =
+        (-(n - 1.0) + std::sqrt((n - 1.0) * (n - 1.0) + 4.0 * m)) / 2.0;
+    const double q2 = (-(n - 1.0) + std::sqrt((n - 1.0) * (n - 1.0) +
+                                              4.0 * rateOverHorizon(c))) /
+                      2.0;
+    const double sInf = c.K / (1.0 - 1.0 / qInf);
+    const double h2 = -(b * c.T + 2.0 * c.sigma * sqrtT) * c.K / (sInf - c.K);
+    const double carry = std::exp(-c.q * c.T);
+
+    double si = c.K + (sInf - c.K) * (1.0 - std::exp(h2));
+    for (int i = 0; i < kMaxCriticalPriceIterations; ++i) {
+      const double d1 = dPlus(c, c.T, si / c.K);
+      const double lhs = si - c.K;
+      const double rhs =
+          european(c, si, true) + (1.0 - carry * cdf(d1)) * si / q2;
+      if (std::abs(lhs - rhs) / c.K < kCriticalPriceTolerance) {
+        break;
+      }
+      const double slope = carry * cdf(d1) * (1.0 - 1.0 / q2) +
+                           (1.0 - carry * pdf(d1) / (c.sigma * sqrtT)) / q2;
+      si = (c.K + rhs - slope * si) / (1.0 - slope);
+    }
+    return si;
+  }
+
+  // Critical spot below which the put is exercised
+  double bawCriticalPut(const Contract &c) {
+    const double b = c.r - c.q;
+    const double v2 = c.sigma * c.sigma;
+    const double sqrtT = std::sqrt(c.T);
+    const double n = 2.0 * b / v2;
+    const double m = 2.0 * c.r / v2;
+    const double qInf =
+        (-(n - 1.0) - std::sqrt((n - 1.0) * (n - 1.0) + 4.0 * m)) / 2.0;
+    const double q1 = (-(n - 1.0) - std::sqrt((n - 1.0) * (n - 1.0) +
+                                              4.0 * rateOverHorizon(c))) /
+                      2.0;
+    const double sInf = c.K / (1.0 - 1.0 / qInf);
+    const double h1 = (b * c.T - 2.0 * c.sigma * sqrtT) * c.K / (c.K - sInf);
+    const double carry = std::exp(-c.q * c.T);
+
+    double si = sInf + (c.K - sInf) * std::exp(h1);
+    for (int i = 0; i < kMaxCriticalPriceIterations; ++i) {
+      const double d1 = dPlus(c, c.T, si / c.K);
+      const double lhs = c.K - si;
+      const double rhs =
+          european(c, si, false) - (1.0 - carry * cdf(-d1)) * si / q1;
+      if (std::abs(lhs - rhs) / c.K < kCriticalPriceTolerance) {
+        break;
+      }
+      const double slope = -carry * cdf(-d1) * (1.0 - 1.0 / q1) -
+                           (1.0 + carry * pdf(-d1) / (c.sigma * sqrtT)) / q1;
+      si = (c.K - rhs + slope * si) / (1.0 + slope);
+    }
+    return si;
+  }
+
+  double bawCall(const Contract &c) {
+    if (c.q <= 0.0) {
+      return european(c, c.S, true); // never exercised early
+    }
+    const double critical = bawCriticalCall(c);
+    if (c.S >= critical) {
+      return c.S - c.K;
+    }
+    const double b = c.r - c.q;
+    const double n = 2.0 * b / (c.sigma * c.sigma);
+    const double q2 = (-(n - 1.0) + std::sqrt((n - 1.0) * (n - 1.0) +
+                                              4.0 * rateOverHorizon(c))) /
+                      2.0;
+    const double a2 =
+        critical / q2 *
+        (1.0 - std::exp(-c.q * c.T) * cdf(dPlus(c, c.T, critical / c.K)));
+    return european(c, c.S, true) + a2 * std::pow(c.S / critical, q2);
+  }
+
+  double bawPut(const Contract &c) {
+    if (c.r <= 0.0) {
+      return european(c, c.S, false); // never exercised early
+    }
+    const double critical = bawCriticalPut(c);
+    if (c.S <= critical) {
+      return c.K - c.S;
+    }
+    const double b = c.r - c.q;
+    const double n = 2.0 * b / (c.sigma * c.sigma);
+    const double q1 = (-(n - 1.0) - std::sqrt((n - 1.0) * (n - 1.0) +
+                                              4.0 * rateOverHorizon(c))) /
+                      2.0;
+    const double a1 =
+        -critical / q1 *
+        (1.0 - std::exp(-c.q * c.T) * cdf(-dPlus(c, c.T, critical / c.K)));
+    return european(c, c.S, false) + a1 * std::pow(c.S / critical, q1);
+  }
+
+  // --- Bjerksund-Stensland 2002 --------------------------------------------
+
+  // the phi and psi functions of the 2002 paper, with b = r - q
+  double bsPhi(const Contract &c, const double &t, const double &gamma,
+               const double &H, const double &I) {
+    const double b = c.r - c.q;
+    const double v2 = c.sigma * c.sigma;
+    const double sqrtT = std::sqrt(t);
+    const double lambda =
+        (-c.r + gamma * b + 0.5 * gamma * (gamma - 1.0) * v2) * t;
+    const double d =
+        -(std::log(c.S / H) + (b + (gamma - 0.5) * v2) * t) / (c.sigma * sqrtT);
+    const double kappa = 2.0 * b / v2 + 2.0 * gamma - 1.0;
+    return std::exp(lambda) * std::pow(c.S, gamma) *
+           (cdf(d) - std::pow(I / c.S, kappa) *
+                         cdf(d - 2.0 * std::log(I / c.S) / (c.sigma * sqrtT)));
+  }
+
+  double bsPsi(const Contract &c, const double &gamma, const double &H,
+               const double &I2, const double &I1, const double &t1) {
+    const double b = c.r - c.q;
+    const double v2 = c.sigma * c.sigma;
+    const double drift = b + (gamma - 0.5) * v2;
+    const double vt1 = c.sigma * std::sqrt(t1);
+    const double vT = c.sigma * std::sqrt(c.T);
+    const double S = c.S;
+
+    const double e1 = (std::log(S / I1) + drift * t1) / vt1;
+    const double e2 = (std::log(I2 * I2 / (S * I1)) + drift * t1) / vt1;
+    const double e3 = (std::log(S / I1) - drift * t1) / vt1;
+    const double e4 = (std::log(I2 * I2 / (S * I1)) - drift * t1) / vt1;
+    const double f1 = (std::log(S / H) + drift * c.T) / vT;
+    const double f2 = (std::log(I2 * I2 / (S * H)) + drift * c.T) / vT;
+    const double f3 = (std::log(I1 * I1 / (S * H)) + drift * c.T) / vT;
+    const double f4 =
+        (std::log(S * I1 * I1 / (H * I2 * I2)) + drift * c.T) / vT;
+
+    const double rho = std::sqrt(t1 / c.T);
+    const double lambda = -c.r + gamma * b + 0.5 * gamma * (gamma - 1.0) * v2;
+    const double kappa = 2.0 * b / v2 + 2.0 * gamma - 1.0;
+    const auto M = NumericalMethods::bivariateNormalCdf;
+    return std::exp(lambda * c.T) * std::pow(S, gamma) *
+           (M(-e1, -f1, rho) - std::pow(I2 / S, kappa) * M(-e2, -f2, rho) -
+            std::pow(I1 / S, kappa) * M(-e3, -f3, -rho) +
+            std::pow(I1 / I2, kappa) * M(-e4, -f4, -rho));
+  }
+
+  double bjerksundStenslandCall(const Contract &c) {
+    if (c.q <= 0.0) {
+      return european(c, c.S, true); // never exercised early
+    }
+    const double b = c.r - c.q;
+    const double v2 = c.sigma * c.sigma;
+    const double K = c.K;
+    const double t1 = 0.5 * (std::sqrt(5.0) - 1.0) * c.T;
+
+    const double beta =
+        (0.5 - b / v2) +
+        std::sqrt((b / v2 - 0.5) * (b / v2 - 0.5) + 2.0 * c.r / v2);
+    const double bInf = beta / (beta - 1.0) * K;
+    const double b0 = std::max(K, c.r / (c.r - b) * K);
+    const double ht1 = -(b * t1 + 2.0 * c.sigma * std::sqrt(t1)) * K * K /
+                       ((bInf - b0) * b0);
+    const double ht2 = -(b * c.T + 2.0 * c.sigma * std::sqrt(c.T)) * K * K /
+                       ((bInf - b0) * b0);
+    const double I1 = b0 + (bInf - b0) * (1.0 - std::exp(ht1));
+    const double I2 = b0 + (bInf - b0) * (1.0 - std::exp(ht2));
+    if (c.S >= I2) {
+      return c.S - K;
+    }
+    const double alpha1 = (I1 - K) * std::pow(I1, -beta);
+    const double alpha2 = (I2 - K) * std::pow(I2, -beta);
+
+    return alpha2 * std::pow(c.S, beta) - alpha2 * bsPhi(c, t1, beta, I2, I2) +
+           bsPhi(c, t1, 1.0, I2, I2) - bsPhi(c, t1, 1.0, I1, I2) -
+           K * bsPhi(c, t1, 0.0, I2, I2) + K * bsPhi(c, t1, 0.0, I1, I2) +
+           alpha1 * bsPhi(c, t1, beta, I1, I2) -
+           alpha1 * bsPsi(c, beta, I1, I2, I1, t1) +
+           bsPsi(c, 1.0, I1, I2, I1, t1) - bsPsi(c, 1.0, K, I2, I1, t1) -
+           K * bsPsi(c, 0.0, I1, I2, I1, t1) + K * bsPsi(c, 0.0, K, I2, I1, t1);
+  }
+
+  // --- exercise boundary fixed point ----------------------------------------
+
+  struct BoundaryRules {
+    QuadratureRule integration;
+    QuadratureRule pricing;
+  };
+
+  // Put exercise boundary B(tau) held as H = log(B / X)^2 at Chebyshev
+  // points in z = sqrt(tau), X = K min(1, r / q) being its limit at expiry;
+  // H is smooth in z where B itself has a square-root singularity.
+  class PutBoundary {
+  public:
+    PutBoundary(const Contract &c, const int &nodes)
+        : limit_(c.q > c.r ? c.K * c.r / c.q : c.K), z_(nodes + 1),
+          H_(nodes + 1, 0.0), weights_(nodes + 1) {
+      const double sqrtT = std::sqrt(c.T);
+      for (int i = 0; i <= nodes; ++i) {
+        z_[i] = 0.5 * sqrtT * (1.0 - std::cos(kPi * i / nodes));
+        // barycentric weights of the Chebyshev-Lobatto points
+        weights_[i] = (i % 2 == 0 ? 1.0 : -1.0) *
+                      (i == 0 || i == nodes ? 0.5 : 1.0);
+      }
+    }
+
+    [[nodiscard]] size_t size() const { return z_.size(); }
+
+    [[nodiscard]] double tau(const size_t &i) const { return z_[i] * z_[i]; }
+
+    [[nodiscard]] double at(const size_t &i) const {
+      return limit_ * std::exp(-std::sqrt(H_[i]));
+    }
+
+    void set(const size_t &i, const double &boundary) {
+      const double x = std::log(std::min(boundary, limit_) / limit_);
+      H_[i] = x * x;
+    }
+
+    [[nodiscard]] double operator()(const double &tau) const {
+      const double z = std::sqrt(std::max(tau, 0.0));
+      double numerator = 0.0;
+      double denominator = 0.0;
+      for (size_t i = 0; i < z_.size(); ++i) {
+        const double dz = z - z_[i];
+        if (dz == 0.0) {
+          return at(i);
+        }
+        numerator += weights_[i] / dz * H_[i];
+        denominator += weights_[i] / dz;
+      }
+      const double H = std::max(numerator / denominator, 0.0);
+      return limit_ * std::exp(-std::sqrt(H));
+    }
+
+  private:
+    double limit_;
+    std::vector<double> z_;
+    std::vector<double> H_;
+    std::vector<double> weights_;
+  };
+
+  // One FP-B sweep of Andersen, Lake and Offengenden: with d(s, x) the
+  // Black-Scholes d at horizon s and moneyness x, and u the time to expiry
+  // at which the boundary is read,
+  //   B(tau) = K e^{-(r-q) tau} N(tau) / D(tau)
+  //   N = n(d-(tau, B/K)) / (sigma sqrt tau)
+  //       + r int_0^tau e^{ru} n(d-(tau-u, B(tau)/B(u))) / (sigma sqrt(tau-u))
+  //   D = n(d+(tau, B/K)) / (sigma sqrt tau) + N(d+(tau, B/K))
+  //       + q int_0^tau e^{qu} [N(d+) + n(d+) / (sigma sqrt(tau-u))]
+  // The integrals are taken over z = sqrt(tau - u), which removes the
+  // inverse square root.
+  void iterateBoundary(const Contract &c, const QuadratureRule &rule,
+                       PutBoundary &boundary) {
+    std::vector<double> next(boundary.size());
+    for (size_t i = 1; i < boundary.size(); ++i) {
+      const double tau = boundary.tau(i);
+      const double B = boundary.at(i);
+      const double sqrtTau = std::sqrt(tau);
+      const double dp = dPlus(c, tau, B / c.K);
+      const double dm = dp - c.sigma * sqrtTau;
+
+      const double half = 0.5 * sqrtTau;
+      double nIntegral = 0.0;
+      double dIntegral = 0.0;
+      for (size_t k = 0; k < rule.nodes.size(); ++k) {
+        const double z = half * (rule.nodes[k] + 1.0);
+        const double s = z * z;
+        const double u = tau - s;
+        const double dpu = dPlus(c, s, B / boundary(u));
+        const double dmu = dpu - c.sigma * z;
+        const double w = half * rule.weights[k];
+        nIntegral += w * std::exp(c.r * u) * pdf(dmu);
+        dIntegral += w * std::exp(c.q * u) *
+                     (2.0 * z * cdf(dpu) + 2.0 * pdf(dpu) / c.sigma);
+      }
+      const double numerator =
+          pdf(dm) / (c.sigma * sqrtTau) + 2.0 * c.r / c.sigma * nIntegral;
+      const double denominator =
+          pdf(dp) / (c.sigma * sqrtTau) + cdf(dp) + c.q * dIntegral;
+      next[i] = c.K * std::exp(-(c.r - c.q) * tau) * numerator / denominator;
+    }
+    for (size_t i = 1; i < boundary.size(); ++i) {
+      boundary.set(i, next[i]);
+    }
+  }
+
+  double boundaryPut(const Contract &c, const ExerciseBoundaryConfig &config,
+                     const BoundaryRules &rules) {
+    if (c.r <= 0.0) {
+      return european(c, c.S, false); // never exercised early
+    }
+
+    // seeded with the Barone-Adesi-Whaley critical price at each node
+    PutBoundary boundary(c, config.collocationNodes);
+    for (size_t i = 1; i < boundary.size(); ++i) {
+      Contract shorter = c;
+      shorter.T = boundary.tau(i);
+      boundary.set(i, bawCriticalPut(shorter));
+    }
+    for (int j = 0; j < config.iterations; ++j) {
+      iterateBoundary(c, rules.integration, boundary);
+    }
+
+    if (c.S <= boundary(c.T)) {
+      return c.K - c.S;
+    }
+
+    // early exercise premium
+    //   int_0^T [r K e^{-rs} N(-d-(s, S/B(T-s)))
+    //            - q S e^{-qs} N(-d+(s, S/B(T-s)))] ds
+    // over z = sqrt(s)
+    const QuadratureRule &rule = rules.pricing;
+    const double half = 0.5 * std::sqrt(c.T);
+    double premium = 0.0;
+    for (size_t k = 0; k < rule.nodes.size(); ++k) {
+      const double z = half * (rule.nodes[k] + 1.0);
+      const double s = z * z;
+      const double dp = dPlus(c, s, c.S / boundary(c.T - s));
+      const double dm = dp - c.sigma * z;
+      premium += half * rule.weights[k] * 2.0 * z *
+                 (c.r * c.K * std::exp(-c.r * s) * cdf(-dm) -
+                  c.q * c.S * std::exp(-c.q * s) * cdf(-dp));
+    }
+    return european(c, c.S, false) + premium;
+  }
+
+  BoundaryRules makeRules(const ExerciseBoundaryConfig &config) {
+    return {NumericalMethods::gaussLegendre(config.integrationNodes),
+            NumericalMethods::gaussLegendre(config.pricingNodes)};
+  }
+
+  double priceContract(const AmericanOption &option,
+                       const AmericanApproximation &method,
+                       const ExerciseBoundaryConfig &config,
+                       const BoundaryRules &rules) {
+    const Contract c = toContract(option);
+    const bool call = option.getType() == OptionType::Call;
+    switch (method) {
+    case AmericanApproximation::BaroneAdesiWhaley:
+      return call ? bawCall(c) : bawPut(c);
+    case AmericanApproximation::BjerksundStensland:
+      return call ? bjerksundStenslandCall(c)
+                  : bjerksundStenslandCall(symmetric(c));
+    case AmericanApproximation::ExerciseBoundary:
+      return call ? boundaryPut(symmetric(c), config, rules)
+                  : boundaryPut(c, config, rules);
+    }
+    return 0.0;
+  }
+
+} // namespace
+
+void AnalyticAmerican::validate(const AmericanOption &option) {
+  if (option.getSpotPrice() <= 0.0) {
+    throw std::invalid_argument(ErrorMessages::BlackScholes::kInvalidSpotPrice);
+  }
+  if (option.getStrikePrice() <= 0.0) {
+    throw std::invalid_argument(
+        ErrorMessages::BlackScholes::kInvalidStrikePrice);
+  }
+  if (option.getRiskFreeRate() < 0.0) {
+    throw std::invalid_argument(
+        ErrorMessages::BlackScholes::kInvalidRiskFreeRate);
+  }
+  if (option.getMaturity() <= 0.0) {
+    throw std::invalid_argument(
+        ErrorMessages::BlackScholes::kInvalidTimeToMaturity);
+  }
+  if (option.getVolatility() <= 0.0) {
+    throw std::invalid_argument(
+        ErrorMessages::BlackScholes::kInvalidVolatility);
+  }
+}
+
+void AnalyticAmerican::validate(const ExerciseBoundaryConfig &config) {
+  if (config.collocationNodes <= 0 || config.iterations < 0 ||
+      config.integrationNodes <= 0 || config.pricingNodes <= 0) {
+    throw std::invalid_argument(
+        ErrorMessages::AnalyticAmerican::kInvalidBoundaryConfig);
+  }
+}
+
+double AnalyticAmerican::baroneAdesiWhaley(const AmericanOption &option) {
+  return price(option, AmericanApproximation::BaroneAdesiWhaley);
+}
+
+double AnalyticAmerican::bjerksundStensland(const AmericanOption &option) {
+  return price(option, AmericanApproximation::BjerksundStensland);
+}
+
+double
+AnalyticAmerican::exerciseBoundary(const AmericanOption &option,
+                                   const ExerciseBoundaryConfig &config) {
+  return price(option, AmericanApproximation::ExerciseBoundary, config);
+}
+
+double AnalyticAmerican::price(const AmericanOption &option,
+                               const AmericanApproximation &method,
+                               const ExerciseBoundaryConfig &config) {
+  validate(option);
+  if (method != AmericanApproximation::ExerciseBoundary) {
+    return priceContract(option, method, config, {});
+  }
+  validate(config);
+  return priceContract(option, method, config, makeRules(config));
+}
+
+void AnalyticAmerican::priceBatch(const std::vector<AmericanOption> &options,
+                                  double *prices,
+                                  const AmericanApproximation &method,
+                                  const ExerciseBoundaryConfig &config,
+                                  const unsigned &threads) {
+  for (const AmericanOption &option : options) {
+    validate(option);
+  }
+  BoundaryRules rules;
+  if (method == AmericanApproximation::ExerciseBoundary) {
+    validate(config);
+    rules = makeRules(config); // shared by every contract
+  }
+  Parallel::forEach(
+      options.size(),
+      [&](const size_t i) {
+        prices[i] = priceContract(options[i], method, config, rules);
+      },
+      threads);
+}
\ No newline at end of file
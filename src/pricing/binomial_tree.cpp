@@ -1,105 +1,744 @@
 #include "pricing/binomial_tree.h"
 #include "error_messages.h"
+#include "utils/parallel.h"
 #include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <vector>
 
-double BinomialTree::price(const AmericanOption &option, const int &numSteps) {
-  if (numSteps <= 0) {
-    throw std::invalid_argument(ErrorMessages::BinomialTree::kInvalidNumSteps);
-  }
+namespace {
+
+  template <OptionType Type> struct Payoff;
+
+  template <> struct Payoff<OptionType::Call> {
+    template <typename Real>
+    static Real apply(const Real &spot, const Real &strike) {
+      return std::max(spot - strike, Real(0));
+    }
+  };
+
+  template <> struct Payoff<OptionType::Put> {
+    template <typename Real>
+    static Real apply(const Real &spot, const Real &strike) {
+      return std::max(strike - spot, Real(0));
+    }
+  };
+
+  // Lattice parameters are derived in double and stored in the engine's
+  // scalar type, so a float tree only rounds the per-node arithmetic.
+  template <typename Real> struct Lattice {
+    int numSteps;
+    Real spot; // escrowed spot when there are discrete dividends
+    Real strike;
+    // per time step: e^{-r_i dt} * p_i and e^{-r_i dt} * (1 - p_i)
+    std::vector<Real> discPu;
+    std::vector<Real> discPd;
+    // per time step: value of the dividends still to be paid, added back to
+    // the escrowed spot to get the underlying at each node
+    std::vector<Real> dividendValue;
+    // powers[numSteps + k] = u^k for k in [-numSteps, numSteps], so the
+    // underlying at node (i, j) is spot * powers[numSteps - i + 2j]
+    std::vector<Real> powers;
+  };
 
-  const double S = option.getSpotPrice();
-  const double r = option.getRiskFreeRate();
-  const double q = option.getDividendYield();
-  const double T = option.getMaturity();
-  const double sigma = option.getVolatility();
+  template <typename OptionT>
+  Lattice<typename OptionT::value_type>
+  buildLattice(const OptionT &option, const int &numSteps,
+               const YieldCurve *curve, const DividendSchedule *dividends) {
+    using Real = typename OptionT::value_type;
 
-  const double dt = T / numSteps;
-  const double u = std::exp(sigma * std::sqrt(dt));
-  const double d = 1.0 / u;
-  const double p = (std::exp((r - q) * dt) - d) / (u - d);
+    const double q = option.getDividendYield();
+    const double T = option.getMaturity();
+    const double sigma = option.getVolatility();
 
-  std::vector<std::vector<double>> stockPrices(
-      numSteps + 1, std::vector<double>(numSteps + 1, 0.0));
-  for (int i = 0; i <= numSteps; ++i) {
-    for (int j = 0; j <= i; ++j) {
-      stockPrices[i][j] = S * std::pow(u, j) * std::pow(d, i - j);
+    const double dt = T / numSteps;
+    const double logU = sigma * std::sqrt(dt);
+    const double u = std::exp(logU);
+    const double d = 1.0 / u;
+
+    Lattice<Real> lattice;
+    lattice.numSteps = numSteps;
+    lattice.strike = option.getStrikePrice();
+    lattice.discPu.resize(numSteps);
+    lattice.discPd.resize(numSteps);
+    lattice.dividendValue.assign(numSteps + 1, Real(0));
+
+    double spot = option.getSpotPrice();
+    if (curve == nullptr) {
+      const double r = option.getRiskFreeRate();
+      const double p = (std::exp((r - q) * dt) - d) / (u - d);
+      const double disc = std::exp(-r * dt);
+      std::fill(lattice.discPu.begin(), lattice.discPu.end(), disc * p);
+      std::fill(lattice.discPd.begin(), lattice.discPd.end(), disc * (1 - p));
+    } else {
+      const std::vector<double> discounts = curve->discountTable(T, numSteps);
+      const double carry = std::exp(-q * dt);
+      for (int i = 0; i < numSteps; ++i) {
+        const double disc = discounts[i + 1] / discounts[i];
+        const double p = (carry / disc - d) / (u - d);
+        lattice.discPu[i] = disc * p;
+        lattice.discPd[i] = disc * (1 - p);
+      }
+      if (dividends != nullptr && !dividends->empty()) {
+        const std::vector<double> remaining =
+            dividends->remainingValueTable(*curve, T, discounts);
+        std::copy(remaining.begin(), remaining.end(),
+                  lattice.dividendValue.begin());
+        spot -= remaining[0];
+        if (spot <= 0.0) {
+          throw std::invalid_argument(
+              ErrorMessages::BlackScholes::kInvalidSpotPrice);
+        }
+      }
     }
+    lattice.spot = spot;
+
+    lattice.powers.resize(2 * numSteps + 1);
+    for (int k = -numSteps; k <= numSteps; ++k) {
+      lattice.powers[numSteps + k] = std::exp(k * logU);
+    }
+    return lattice;
   }
 
-  std::vector<double> optionValues(numSteps + 1);
-  for (int j = 0; j <= numSteps; ++j) {
-    optionValues[j] = option.payoffImpl(stockPrices[numSteps][j]);
+  // One backward step from level step + 1 to level step, in place, over the
+  // nodes [first, first + count); values[0] holds node first
+  template <OptionType Type, bool EarlyExercise, typename Real>
+  void rollback(const Lattice<Real> &lattice, const int &step,
+                const int &first, const int &count, Real *values) {
+    const Real *powers =
+        lattice.powers.data() + lattice.numSteps - step + 2 * first;
+    const Real S = lattice.spot;
+    const Real K = lattice.strike;
+    const Real D = lattice.dividendValue[step];
+    const Real pu = lattice.discPu[step];
+    const Real pd = lattice.discPd[step];
+    for (int j = 0; j < count; ++j) {
+      const Real continuation = pu * values[j + 1] + pd * values[j];
+      if constexpr (EarlyExercise) {
+        values[j] = std::max(continuation,
+                             Payoff<Type>::apply(S * powers[2 * j] + D, K));
+      } else {
+        values[j] = continuation;
+      }
+    }
   }
 
-  // Backward induction
-  for (int i = numSteps - 1; i >= 0; --i) {
-    for (int j = 0; j <= i; ++j) {
-      double continuationValue =
-          std::exp(-r * dt) *
-          (p * optionValues[j + 1] + (1 - p) * optionValues[j]);
-      if (option.isAmerican()) {
-        // early exercise
-        optionValues[j] =
-            std::max(continuationValue, option.payoffImpl(stockPrices[i][j]));
+  template <OptionType Type, ExerciseStyle Style, typename Real>
+  void rollbackSlice(const Lattice<Real> &lattice,
+                     const std::vector<char> &exercisable, const int &step,
+                     const int &first, const int &count, Real *values) {
+    if constexpr (Style == ExerciseStyle::American) {
+      rollback<Type, true>(lattice, step, first, count, values);
+    } else if constexpr (Style == ExerciseStyle::European) {
+      rollback<Type, false>(lattice, step, first, count, values);
+    } else {
+      // the schedule is resolved per time slice, never per node
+      if (exercisable[step]) {
+        rollback<Type, true>(lattice, step, first, count, values);
       } else {
-        optionValues[j] = continuationValue;
+        rollback<Type, false>(lattice, step, first, count, values);
       }
     }
   }
 
-  return optionValues[0];
+  template <OptionType Type, typename Real>
+  std::vector<Real> terminalValues(const Lattice<Real> &lattice) {
+    const int N = lattice.numSteps;
+    const Real *powers = lattice.powers.data();
+    std::vector<Real> values(N + 1);
+    for (int j = 0; j <= N; ++j) {
+      values[j] = Payoff<Type>::apply(lattice.spot * powers[2 * j],
+                                      lattice.strike);
+    }
+    return values;
+  }
+
+  template <OptionType Type, ExerciseStyle Style, typename Real>
+  Real backwardInduction(const Lattice<Real> &lattice,
+                         const std::vector<char> &exercisable) {
+    std::vector<Real> values = terminalValues<Type>(lattice);
+    for (int i = lattice.numSteps - 1; i >= 0; --i) {
+      rollbackSlice<Type, Style>(lattice, exercisable, i, 0, i + 1,
+                                 values.data());
+    }
+    return values[0];
+  }
+
+  // The American backward induction differentiated node by node in sigma.
+  // With s = sqrt(dt), an underlying S u^k moves by k s S u^k, and p =
+  // (a - d) / (u - d) by s (d (u - d) - (a - d)(u + d)) / (u - d)^2 with a =
+  // e^{(r - q) dt}. A node where exercise wins takes the payoff's slope,
+  // elsewhere the continuation's.
+  template <OptionType Type>
+  LatticeSensitivity vegaInduction(const AmericanOption &option,
+                                   const int &numSteps) {
+    constexpr double sign = Type == OptionType::Call ? 1.0 : -1.0;
+    const Lattice<double> lattice =
+        buildLattice(option, numSteps, nullptr, nullptr);
+    const int N = numSteps;
+    const double *powers = lattice.powers.data();
+    const double S = lattice.spot;
+    const double K = lattice.strike;
+
+    const double dt = option.getMaturity() / N;
+    const double s = std::sqrt(dt);
+    const double u = std::exp(option.getVolatility() * s);
+    const double d = 1.0 / u;
+    const double a =
+        std::exp((option.getRiskFreeRate() - option.getDividendYield()) * dt);
+    const double disc = std::exp(-option.getRiskFreeRate() * dt);
+    const double dp =
+        s * (d * (u - d) - (a - d) * (u + d)) / ((u - d) * (u - d));
+    const double dPu = disc * dp;
+    const double dPd = -disc * dp;
+
+    std::vector<double> values(N + 1);
+    std::vector<double> vegas(N + 1);
+    for (int j = 0; j <= N; ++j) {
+      const double x = S * powers[2 * j];
+      values[j] = Payoff<Type>::apply(x, K);
+      vegas[j] = values[j] > 0.0 ? sign * (2 * j - N) * s * x : 0.0;
+    }
+
+    for (int i = N - 1; i >= 0; --i) {
+      const double pu = lattice.discPu[i];
+      const double pd = lattice.discPd[i];
+      const double D = lattice.dividendValue[i];
+      const double *row = powers + N - i;
+      for (int j = 0; j <= i; ++j) {
+        const double continuation = pu * values[j + 1] + pd * values[j];
+        vegas[j] = pu * vegas[j + 1] + pd * vegas[j] + dPu * values[j + 1] +
+                   dPd * values[j];
+        values[j] = std::max(continuation,
+                             Payoff<Type>::apply(S * row[2 * j] + D, K));
+      }
+      // The exercise region is contiguous from the deep in-the-money end, so
+      // its edge is found by bisection and its slopes patched afterwards,
+      // which keeps the loop above free of selects.
+      const auto exercised = [&](const int &j) {
+        const double exercise = Payoff<Type>::apply(S * row[2 * j] + D, K);
+        return exercise > 0.0 && values[j] == exercise;
+      };
+      int first = 0;
+      int last = i + 1;
+      while (first < last) {
+        const int mid = (first + last) / 2;
+        if (exercised(mid) == (Type == OptionType::Put)) {
+          first = mid + 1;
+        } else {
+          last = mid;
+        }
+      }
+      const int begin = Type == OptionType::Put ? 0 : first;
+      const int end = Type == OptionType::Put ? first : i + 1;
+      for (int j = begin; j < end; ++j) {
+        vegas[j] = sign * (2 * j - i) * s * (S * row[2 * j]);
+      }
+    }
+
+    return {values[0], vegas[0]};
+  }
+
+  // Temporal blocking: each block advances config.blockSteps levels at once.
+  // A tile owning the nodes [first, last) of the block's bottom level starts
+  // from [first, last + steps) of its top level and loses one node on the
+  // right per step, a trapezoid that needs nothing from its neighbours, so
+  // the tiles of a block run in parallel. The workers are started once per
+  // induction, take the tiles of every block round-robin and meet at a
+  // barrier between blocks. Levels are double buffered and each node sees
+  // the serial operations in the serial order, so the result is
+  // bit-identical to backwardInduction.
+  template <OptionType Type, ExerciseStyle Style, typename Real>
+  Real wavefrontInduction(const Lattice<Real> &lattice,
+                          const std::vector<char> &exercisable,
+                          const unsigned &threads,
+                          const WavefrontConfig &config) {
+    std::vector<Real> levels[2] = {terminalValues<Type>(lattice), {}};
+    levels[1].resize(levels[0].size());
+    const int width = config.tileWidth;
+    const int firstBottom = std::max(lattice.numSteps - config.blockSteps, 0);
+    const size_t workers = std::min<size_t>(
+        threads == 0 ? Parallel::defaultThreadCount() : threads,
+        static_cast<size_t>(firstBottom / width) + 1);
+
+    // allocated up front so nothing can throw between two barriers
+    std::vector<std::vector<Real>> scratch(
+        workers, std::vector<Real>(width + config.blockSteps));
+    Barrier barrier(workers);
+    int blocks = 0;
+
+    // forEach starts exactly `workers` threads for `workers` items and no
+    // item can finish before all of them reach the first barrier, so every
+    // thread runs one worker
+    Parallel::forEach(
+        workers,
+        [&](const size_t worker) {
+          Real *values = scratch[worker].data();
+          int block = 0;
+          for (int level = lattice.numSteps; level > 0; ++block) {
+            const int bottom = std::max(level - config.blockSteps, 0);
+            const size_t tiles = static_cast<size_t>(bottom / width) + 1;
+            const std::vector<Real> &current = levels[block % 2];
+            std::vector<Real> &next = levels[(block + 1) % 2];
+            for (size_t tile = worker; tile < tiles; tile += workers) {
+              const int first = static_cast<int>(tile) * width;
+              const int last = std::min(first + width, bottom + 1);
+              std::copy(current.begin() + first,
+                        current.begin() + last + level - bottom, values);
+              for (int i = level - 1; i >= bottom; --i) {
+                rollbackSlice<Type, Style>(lattice, exercisable, i, first,
+                                           last - first + i - bottom, values);
+              }
+              std::copy(values, values + (last - first),
+                        next.begin() + first);
+            }
+            barrier.arriveAndWait();
+            level = bottom;
+          }
+          if (worker == 0) {
+            blocks = block;
+          }
+        },
+        static_cast<unsigned>(workers));
+    return levels[blocks % 2][0];
+  }
+
+  template <typename OptionT>
+  std::vector<char> exerciseSchedule(const OptionT &, const int &) {
+    return {};
+  }
+
+  template <typename Real>
+  std::vector<char> exerciseSchedule(const BasicBermudanOption<Real> &option,
+                                     const int &numSteps) {
+    std::vector<char> exercisable(numSteps + 1, 0);
+    const double T = option.getMaturity();
+    for (const Real &t : option.getExerciseTimes()) {
+      if (t < 0.0 || t > T) {
+        continue;
+      }
+      const long step = std::lround(t / T * numSteps);
+      exercisable[std::clamp<long>(step, 0, numSteps)] = 1;
+    }
+    return exercisable;
+  }
+
+  // Up to kBatchLanes American options priced together. Entry (j, lane) of
+  // the node buffer and of the powers table is at j * kBatchLanes + lane;
+  // calls and puts share the lane loop through the payoff sign. Every lane
+  // performs the scalar tree's operations in the same order, so the prices
+  // match BinomialTree::price exactly.
+  template <typename Real>
+  void priceLaneGroup(const BasicAmericanOption<Real> *options,
+                      const size_t &count, const int &numSteps, Real *prices) {
+    constexpr int W = BinomialTree::kBatchLanes<Real>;
+    const int N = numSteps;
+    Real spot[W];
+    Real strike[W];
+    Real sign[W];
+    Real pu[W];
+    Real pd[W];
+    std::vector<Real> powers(static_cast<size_t>(2 * N + 1) * W);
+    std::vector<Real> values(static_cast<size_t>(N + 1) * W);
+
+    for (int l = 0; l < W; ++l) {
+      // lanes past the end of the book repeat its last option
+      const BasicAmericanOption<Real> &option =
+          options[std::min<size_t>(l, count - 1)];
+      const double r = option.getRiskFreeRate();
+      const double q = option.getDividendYield();
+      const double T = option.getMaturity();
+      const double sigma = option.getVolatility();
+      const double dt = T / N;
+      const double logU = sigma * std::sqrt(dt);
+      const double u = std::exp(logU);
+      const double d = 1.0 / u;
+      const double p = (std::exp((r - q) * dt) - d) / (u - d);
+      const double disc = std::exp(-r * dt);
+      pu[l] = disc * p;
+      pd[l] = disc * (1 - p);
+      spot[l] = option.getSpotPrice();
+      strike[l] = option.getStrikePrice();
+      sign[l] = option.getType() == OptionType::Call ? Real(1) : Real(-1);
+      for (int k = -N; k <= N; ++k) {
+        powers[static_cast<size_t>(N + k) * W + l] = std::exp(k * logU);
+      }
+    }
+
+    for (int j = 0; j <= N; ++j) {
+      const Real *pw = powers.data() + static_cast<size_t>(2 * j) * W;
+      Real *v = values.data() + static_cast<size_t>(j) * W;
+      for (int l = 0; l < W; ++l) {
+        v[l] = std::max(sign[l] * (spot[l] * pw[l] - strike[l]), Real(0));
+      }
+    }
+
+    for (int i = N - 1; i >= 0; --i) {
+      const Real *row = powers.data() + static_cast<size_t>(N - i) * W;
+      for (int j = 0; j <= i; ++j) {
+        const Real *pw = row + static_cast<size_t>(2 * j) * W;
+        Real *v = values.data() + static_cast<size_t>(j) * W;
+        for (int l = 0; l < W; ++l) {
+          const Real continuation = pu[l] * v[W + l] + pd[l] * v[l];
+          const Real exercise =
+              std::max(sign[l] * (spot[l] * pw[l] - strike[l]), Real(0));
+          v[l] = std::max(continuation, exercise);
+        }
+      }
+    }
+
+    std::copy(values.begin(), values.begin() + count, prices);
+  }
+
+} // namespace
+
+template <typename Real>
+void BinomialTree::priceBatch(
+    const std::vector<BasicAmericanOption<Real>> &options, const int &numSteps,
+    Real *prices, const unsigned &threads) {
+  if (numSteps <= 0) {
+    throw std::invalid_argument(ErrorMessages::BinomialTree::kInvalidNumSteps);
+  }
+  constexpr size_t W = kBatchLanes<Real>;
+  const size_t groups = (options.size() + W - 1) / W;
+  Parallel::forEach(
+      groups,
+      [&](const size_t group) {
+        const size_t first = group * W;
+        priceLaneGroup(options.data() + first,
+                       std::min(W, options.size() - first), numSteps,
+                       prices + first);
+      },
+      threads);
+}
+
+template <typename OptionT>
+typename OptionT::value_type
+BinomialTree::priceImpl(const OptionT &option, const int &numSteps,
+                        const YieldCurve *curve,
+                        const DividendSchedule *dividends) {
+  if (numSteps <= 0) {
+    throw std::invalid_argument(ErrorMessages::BinomialTree::kInvalidNumSteps);
+  }
+
+  constexpr ExerciseStyle style = OptionT::kExerciseStyle;
+  const auto lattice = buildLattice(option, numSteps, curve, dividends);
+  const std::vector<char> exercisable = exerciseSchedule(option, numSteps);
+
+  if (option.getType() == OptionType::Call) {
+    return backwardInduction<OptionType::Call, style>(lattice, exercisable);
+  }
+  return backwardInduction<OptionType::Put, style>(lattice, exercisable);
+}
+
+template <typename OptionT>
+typename OptionT::value_type
+BinomialTree::priceParallelImpl(const OptionT &option, const int &numSteps,
+                                const unsigned &threads,
+                                const WavefrontConfig &config) {
+  if (numSteps <= 0) {
+    throw std::invalid_argument(ErrorMessages::BinomialTree::kInvalidNumSteps);
+  }
+  if (config.tileWidth <= 0 || config.blockSteps <= 0) {
+    throw std::invalid_argument(
+        ErrorMessages::BinomialTree::kInvalidWavefrontConfig);
+  }
+
+  constexpr ExerciseStyle style = OptionT::kExerciseStyle;
+  const auto lattice = buildLattice(option, numSteps, nullptr, nullptr);
+  const std::vector<char> exercisable = exerciseSchedule(option, numSteps);
+
+  if (option.getType() == OptionType::Call) {
+    return wavefrontInduction<OptionType::Call, style>(lattice, exercisable,
+                                                       threads, config);
+  }
+  return wavefrontInduction<OptionType::Put, style>(lattice, exercisable,
+                                                    threads, config);
+}
+
+LatticeSensitivity BinomialTree::priceWithVega(const AmericanOption &option,
+                                               const int &numSteps) {
+  if (numSteps <= 0) {
+    throw std::invalid_argument(ErrorMessages::BinomialTree::kInvalidNumSteps);
+  }
+  if (option.getType() == OptionType::Call) {
+    return vegaInduction<OptionType::Call>(option, numSteps);
+  }
+  return vegaInduction<OptionType::Put>(option, numSteps);
 }
 
-double BinomialTree::delta(const AmericanOption &option, const int &numSteps) {
-  const double S = option.getSpotPrice();
-  const double deltaS = 0.01 * S;
+template <typename OptionT>
+typename OptionT::value_type
+BinomialTree::deltaImpl(const OptionT &option, const int &numSteps,
+                        const YieldCurve *curve,
+                        const DividendSchedule *dividends) {
+  using Real = typename OptionT::value_type;
+  const Real S = option.getSpotPrice();
+  const Real deltaS = Real(0.01) * S;
 
-  AmericanOption optionPlus = option;
+  OptionT optionPlus = option;
   optionPlus.setSpotPrice(S + deltaS);
-  const double pricePlus = price(optionPlus, numSteps);
+  const Real pricePlus = priceImpl(optionPlus, numSteps, curve, dividends);
 
-  AmericanOption optionMinus = option;
+  OptionT optionMinus = option;
   optionMinus.setSpotPrice(S - deltaS);
-  const double priceMinus = price(optionMinus, numSteps);
+  const Real priceMinus = priceImpl(optionMinus, numSteps, curve, dividends);
 
   return (pricePlus - priceMinus) / (2 * deltaS);
 }
 
-double BinomialTree::gamma(const AmericanOption &option, const int &numSteps) {
+template <typename OptionT>
+typename OptionT::value_type
+BinomialTree::gammaImpl(const OptionT &option, const int &numSteps,
+                        const YieldCurve *curve,
+                        const DividendSchedule *dividends) {
+  using Real = typename OptionT::value_type;
   // Calculate option prices with slightly higher and lower spot prices
-  const double S = option.getSpotPrice();
-  const double deltaS = 0.01 * S;
+  const Real S = option.getSpotPrice();
+  const Real deltaS = Real(0.01) * S;
 
-  AmericanOption optionPlus = option;
+  OptionT optionPlus = option;
   optionPlus.setSpotPrice(S + deltaS);
 
-  AmericanOption optionMinus = option;
+  OptionT optionMinus = option;
   optionMinus.setSpotPrice(S - deltaS);
 
-  return (delta(optionPlus, numSteps) - delta(optionMinus, numSteps)) /
+  return (deltaImpl(optionPlus, numSteps, curve, dividends) -
+          deltaImpl(optionMinus, numSteps, curve, dividends)) /
          (2 * deltaS);
 }
 
-double BinomialTree::theta(const AmericanOption &option, const int &numSteps) {
+template <typename OptionT>
+typename OptionT::value_type
+BinomialTree::thetaImpl(const OptionT &option, const int &numSteps,
+                        const YieldCurve *curve,
+                        const DividendSchedule *dividends) {
+  using Real = typename OptionT::value_type;
   // Calculate option prices with slightly shorter and longer times to maturity
-  const double &T = option.getMaturity();
-  const double &deltaT =
-      0.01; // Small change in time to maturity (e.g., 1/100 of a year)
+  const Real &T = option.getMaturity();
+  const Real &deltaT =
+      Real(0.01); // Small change in time to maturity (e.g., 1/100 of a year)
 
-  AmericanOption optionPlus = option;
-  optionPlus.setMaturity(std::max(0.0, T - deltaT));
+  OptionT optionPlus = option;
+  optionPlus.setMaturity(std::max(Real(0), T - deltaT));
 
-  AmericanOption optionMinus = option;
+  OptionT optionMinus = option;
   optionMinus.setMaturity(T + deltaT);
 
-  return (price(optionPlus, numSteps) - price(optionMinus, numSteps)) /
+  return (priceImpl(optionPlus, numSteps, curve, dividends) -
+          priceImpl(optionMinus, numSteps, curve, dividends)) /
          (2 * deltaT);
 }
 
-double BinomialTree::calculateOptionValue(const double &underlyingPrice,
-                                          const AmericanOption &option) {
-  return option.payoffImpl(underlyingPrice);
-}
\ No newline at end of file
+template <typename Real>
+Real BinomialTree::price(const BasicAmericanOption<Real> &option,
+                         const int &numSteps) {
+  return priceImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::price(const BasicEuropeanOption<Real> &option,
+                         const int &numSteps) {
+  return priceImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::price(const BasicBermudanOption<Real> &option,
+                         const int &numSteps) {
+  return priceImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::priceParallel(const BasicAmericanOption<Real> &option,
+                                 const int &numSteps, const unsigned &threads,
+                                 const WavefrontConfig &config) {
+  return priceParallelImpl(option, numSteps, threads, config);
+}
+
+template <typename Real>
+Real BinomialTree::priceParallel(const BasicEuropeanOption<Real> &option,
+                                 const int &numSteps, const unsigned &threads,
+                                 const WavefrontConfig &config) {
+  return priceParallelImpl(option, numSteps, threads, config);
+}
+
+template <typename Real>
+Real BinomialTree::priceParallel(const BasicBermudanOption<Real> &option,
+                                 const int &numSteps, const unsigned &threads,
+                                 const WavefrontConfig &config) {
+  return priceParallelImpl(option, numSteps, threads, config);
+}
+
+double BinomialTree::price(const AmericanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return priceImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::price(const EuropeanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return priceImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::price(const BermudanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return priceImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::delta(const AmericanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return deltaImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::delta(const EuropeanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return deltaImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::delta(const BermudanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return deltaImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::gamma(const AmericanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return gammaImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::gamma(const EuropeanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return gammaImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::gamma(const BermudanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return gammaImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::theta(const AmericanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return thetaImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::theta(const EuropeanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return thetaImpl(option, numSteps, &curve, &dividends);
+}
+
+double BinomialTree::theta(const BermudanOption &option, const int &numSteps,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return thetaImpl(option, numSteps, &curve, &dividends);
+}
+
+template <typename Real>
+Real BinomialTree::delta(const BasicAmericanOption<Real> &option,
+                         const int &numSteps) {
+  return deltaImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::delta(const BasicEuropeanOption<Real> &option,
+                         const int &numSteps) {
+  return deltaImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::delta(const BasicBermudanOption<Real> &option,
+                         const int &numSteps) {
+  return deltaImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::gamma(const BasicAmericanOption<Real> &option,
+                         const int &numSteps) {
+  return gammaImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::gamma(const BasicEuropeanOption<Real> &option,
+                         const int &numSteps) {
+  return gammaImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::gamma(const BasicBermudanOption<Real> &option,
+                         const int &numSteps) {
+  return gammaImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::theta(const BasicAmericanOption<Real> &option,
+                         const int &numSteps) {
+  return thetaImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::theta(const BasicEuropeanOption<Real> &option,
+                         const int &numSteps) {
+  return thetaImpl(option, numSteps);
+}
+
+template <typename Real>
+Real BinomialTree::theta(const BasicBermudanOption<Real> &option,
+                         const int &numSteps) {
+  return thetaImpl(option, numSteps);
+}
+
+template float BinomialTree::price(const AmericanOptionF &, const int &);
+template double BinomialTree::price(const AmericanOption &, const int &);
+template float BinomialTree::price(const EuropeanOptionF &, const int &);
+template double BinomialTree::price(const EuropeanOption &, const int &);
+template float BinomialTree::price(const BermudanOptionF &, const int &);
+template double BinomialTree::price(const BermudanOption &, const int &);
+template float BinomialTree::priceParallel(const AmericanOptionF &, const int &,
+                                           const unsigned &,
+                                           const WavefrontConfig &);
+template double BinomialTree::priceParallel(const AmericanOption &, const int &,
+                                            const unsigned &,
+                                            const WavefrontConfig &);
+template float BinomialTree::priceParallel(const EuropeanOptionF &, const int &,
+                                           const unsigned &,
+                                           const WavefrontConfig &);
+template double BinomialTree::priceParallel(const EuropeanOption &, const int &,
+                                            const unsigned &,
+                                            const WavefrontConfig &);
+template float BinomialTree::priceParallel(const BermudanOptionF &, const int &,
+                                           const unsigned &,
+                                           const WavefrontConfig &);
+template double BinomialTree::priceParallel(const BermudanOption &, const int &,
+                                            const unsigned &,
+                                            const WavefrontConfig &);
+template void BinomialTree::priceBatch(const std::vector<AmericanOptionF> &,
+                                       const int &, float *, const unsigned &);
+template void BinomialTree::priceBatch(const std::vector<AmericanOption> &,
+                                       const int &, double *,
+                                       const unsigned &);
+template float BinomialTree::delta(const AmericanOptionF &, const int &);
+template double BinomialTree::delta(const AmericanOption &, const int &);
+template float BinomialTree::delta(const EuropeanOptionF &, const int &);
+template double BinomialTree::delta(const EuropeanOption &, const int &);
+template float BinomialTree::delta(const BermudanOptionF &, const int &);
+template double BinomialTree::delta(const BermudanOption &, const int &);
+template float BinomialTree::gamma(const AmericanOptionF &, const int &);
+template double BinomialTree::gamma(const AmericanOption &, const int &);
+template float BinomialTree::gamma(const EuropeanOptionF &, const int &);
+template double BinomialTree::gamma(const EuropeanOption &, const int &);
+template float BinomialTree::gamma(const BermudanOptionF &, const int &);
+template double BinomialTree::gamma(const BermudanOption &, const int &);
+template float BinomialTree::theta(const AmericanOptionF &, const int &);
+template double BinomialTree::theta(const AmericanOption &, const int &);
+template float BinomialTree::theta(const EuropeanOptionF &, const int &);
+template double BinomialTree::theta(const EuropeanOption &, const int &);
+template float BinomialTree::theta(const BermudanOptionF &, const int &);
+template double BinomialTree::theta(const BermudanOption &, const int &);
\ No newline at end of file
@@ -1,36 +1,22 @@
 #include "pricing/black_scholes.h"
 #include "error_messages.h" // Include the header for error messages
+#include "utils/numerical_methods.h"
 #include <cmath>
 #include <stdexcept>
 
 // cdf of the normal distribution
-double BlackScholes::normal(const double &x) {
-  constexpr double a1 = 0.31938153;
-  constexpr double a2 = -0.356563782;
-  constexpr double a3 = 1.781477937;
-  constexpr double a4 = -1.821255978;
-  constexpr double a5 = 1.330274429;
-  // constexpr double pi = 3.14159265358979323846;
-  constexpr double one_over_sqrt_two_pi = 0.39894228040143267793994605993438;
-
-  const double k = 1.0 / (1.0 + 0.2316419 * std::abs(x));
-  const double cnd = one_over_sqrt_two_pi * std::exp(-x * x / 2.0) *
-                     (a1 * k + a2 * k * k + a3 * std::pow(k, 3) +
-                      a4 * std::pow(k, 4) + a5 * std::pow(k, 5));
-
-  if (x >= 0.0) {
-    return 1.0 - cnd;
-  }
-  return cnd;
+template <typename Real> Real BlackScholes::normal(const Real &x) {
+  return NumericalMethods::normalCdf(x);
 }
 
-double BlackScholes::calculate_d1(const EuropeanOption &option) {
-  const double S = option.getSpotPrice();
-  const double K = option.getStrikePrice();
-  const double r = option.getRiskFreeRate();
-  const double q = option.getDividendYield();
-  const double T = option.getMaturity();
-  const double sigma = option.getVolatilityImpl();
+template <typename Real>
+Real BlackScholes::calculate_d1(const BasicEuropeanOption<Real> &option) {
+  const Real S = option.getSpotPrice();
+  const Real K = option.getStrikePrice();
+  const Real r = option.getRiskFreeRate();
+  const Real q = option.getDividendYield();
+  const Real T = option.getMaturity();
+  const Real sigma = option.getVolatilityImpl();
 
   if (S <= 0.0) {
     throw std::invalid_argument(ErrorMessages::BlackScholes::kInvalidSpotPrice);
@@ -52,13 +38,14 @@ double BlackScholes::calculate_d1(const EuropeanOption &option) {
         ErrorMessages::BlackScholes::kInvalidVolatility);
   }
 
-  return (std::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) /
+  return (std::log(S / K) + (r - q + Real(0.5) * sigma * sigma) * T) /
          (sigma * std::sqrt(T));
 }
 
-double BlackScholes::calculate_d2(const EuropeanOption &option) {
-  const double T = option.getMaturity();
-  const double sigma = option.getVolatilityImpl();
+template <typename Real>
+Real BlackScholes::calculate_d2(const BasicEuropeanOption<Real> &option) {
+  const Real T = option.getMaturity();
+  const Real sigma = option.getVolatilityImpl();
 
   // Input validation using exceptions and fine-grained error messages
   if (T <= 0.0) {
@@ -74,12 +61,13 @@ double BlackScholes::calculate_d2(const EuropeanOption &option) {
 }
 
 // Calculate the price of a European option using the Black-Scholes formula
-double BlackScholes::price(const EuropeanOption &option) {
-  const double S = option.getSpotPrice();
-  const double K = option.getStrikePrice();
-  const double r = option.getRiskFreeRate();
-  const double q = option.getDividendYield();
-  const double T = option.getMaturity();
+template <typename Real>
+Real BlackScholes::price(const BasicEuropeanOption<Real> &option) {
+  const Real S = option.getSpotPrice();
+  const Real K = option.getStrikePrice();
+  const Real r = option.getRiskFreeRate();
+  const Real q = option.getDividendYield();
+  const Real T = option.getMaturity();
 
   // Input validation using exceptions and fine-grained error messages
   if (S <= 0.0) {
@@ -98,8 +86,8 @@ double BlackScholes::price(const EuropeanOption &option) {
         ErrorMessages::BlackScholes::kInvalidTimeToMaturity);
   }
 
-  const double d1 = calculate_d1(option); // Could potentially throw
-  const double d2 = calculate_d2(option); // Could potentially throw
+  const Real d1 = calculate_d1(option); // Could potentially throw
+  const Real d2 = calculate_d2(option); // Could potentially throw
 
   if (option.getType() == OptionType::Call) {
     return S * std::exp(-q * T) * normal(d1) -
@@ -110,11 +98,12 @@ double BlackScholes::price(const EuropeanOption &option) {
 }
 
 // Calculate the Delta of a European option
-double BlackScholes::delta(const EuropeanOption &option) {
-  const double S = option.getSpotPrice();
-  const double r = option.getRiskFreeRate();
-  const double q = option.getDividendYield();
-  const double T = option.getMaturity();
+template <typename Real>
+Real BlackScholes::delta(const BasicEuropeanOption<Real> &option) {
+  const Real S = option.getSpotPrice();
+  const Real r = option.getRiskFreeRate();
+  const Real q = option.getDividendYield();
+  const Real T = option.getMaturity();
 
   // Input validation using exceptions and fine-grained error messages
   if (S <= 0.0) {
@@ -129,20 +118,21 @@ double BlackScholes::delta(const EuropeanOption &option) {
         ErrorMessages::BlackScholes::kInvalidTimeToMaturity);
   }
 
-  const double d1 = calculate_d1(option); // Could potentially throw
+  const Real d1 = calculate_d1(option); // Could potentially throw
 
   if (option.getType() == OptionType::Call) {
     return std::exp(-q * T) * normal(d1);
   }
-  return std::exp(-q * T) * (normal(d1) - 1);
+  return std::exp(-q * T) * (normal(d1) - Real(1));
 }
 
 // Calculate the Gamma of a European option
-double BlackScholes::gamma(const EuropeanOption &option) {
-  const double S = option.getSpotPrice();
-  const double q = option.getDividendYield();
-  const double T = option.getMaturity();
-  const double sigma = option.getVolatilityImpl();
+template <typename Real>
+Real BlackScholes::gamma(const BasicEuropeanOption<Real> &option) {
+  const Real S = option.getSpotPrice();
+  const Real q = option.getDividendYield();
+  const Real T = option.getMaturity();
+  const Real sigma = option.getVolatilityImpl();
 
   // Input validation using exceptions and fine-grained error messages
   if (S <= 0.0) {
@@ -157,17 +147,19 @@ double BlackScholes::gamma(const EuropeanOption &option) {
         ErrorMessages::BlackScholes::kInvalidVolatility);
   }
 
-  const double d1 = calculate_d1(option); // Could potentially throw
-  constexpr double one_over_sqrt_two_pi = 0.39894228040143267793994605993438;
+  const Real d1 = calculate_d1(option); // Could potentially throw
+  constexpr Real one_over_sqrt_two_pi =
+      Real(0.39894228040143267793994605993438);
 
-  return std::exp(-q * T) * one_over_sqrt_two_pi * std::exp(-d1 * d1 / 2.0) /
-         (S * sigma * std::sqrt(T));
+  return std::exp(-q * T) * one_over_sqrt_two_pi *
+         std::exp(-d1 * d1 / Real(2)) / (S * sigma * std::sqrt(T));
 }
 
-double BlackScholes::vega(const EuropeanOption &option) {
-  const double S = option.getSpotPrice();
-  const double q = option.getDividendYield();
-  const double T = option.getMaturity();
+template <typename Real>
+Real BlackScholes::vega(const BasicEuropeanOption<Real> &option) {
+  const Real S = option.getSpotPrice();
+  const Real q = option.getDividendYield();
+  const Real T = option.getMaturity();
 
   if (S <= 0.0) {
     throw std::invalid_argument(ErrorMessages::BlackScholes::kInvalidSpotPrice);
@@ -177,20 +169,22 @@ double BlackScholes::vega(const EuropeanOption &option) {
         ErrorMessages::BlackScholes::kInvalidTimeToMaturity);
   }
 
-  const double d1 = calculate_d1(option); // Could potentially throw
-  constexpr double one_over_sqrt_two_pi = 0.39894228040143267793994605993438;
+  const Real d1 = calculate_d1(option); // Could potentially throw
+  constexpr Real one_over_sqrt_two_pi =
+      Real(0.39894228040143267793994605993438);
 
   return S * std::exp(-q * T) * std::sqrt(T) * one_over_sqrt_two_pi *
-         std::exp(-d1 * d1 / 2.0);
+         std::exp(-d1 * d1 / Real(2));
 }
 
-double BlackScholes::theta(const EuropeanOption &option) {
-  const double S = option.getSpotPrice();
-  const double K = option.getStrikePrice();
-  const double r = option.getRiskFreeRate();
-  const double q = option.getDividendYield();
-  const double T = option.getMaturity();
-  const double sigma = option.getVolatilityImpl();
+template <typename Real>
+Real BlackScholes::theta(const BasicEuropeanOption<Real> &option) {
+  const Real S = option.getSpotPrice();
+  const Real K = option.getStrikePrice();
+  const Real r = option.getRiskFreeRate();
+  const Real q = option.getDividendYield();
+  const Real T = option.getMaturity();
+  const Real sigma = option.getVolatilityImpl();
 
   if (S <= 0.0) {
     throw std::invalid_argument(ErrorMessages::BlackScholes::kInvalidSpotPrice);
@@ -212,16 +206,18 @@ double BlackScholes::theta(const EuropeanOption &option) {
         ErrorMessages::BlackScholes::kInvalidVolatility);
   }
 
-  const double d1 = calculate_d1(option);
-  const double d2 = calculate_d2(option);
-  constexpr double one_over_sqrt_two_pi = 0.39894228040143267793994605993438;
+  const Real d1 = calculate_d1(option);
+  const Real d2 = calculate_d2(option);
+  constexpr Real one_over_sqrt_two_pi =
+      Real(0.39894228040143267793994605993438);
 
-  const double term1 = S * std::exp(-q * T) * one_over_sqrt_two_pi *
-                       std::exp(-d1 * d1 / 2.0) * sigma / (2.0 * std::sqrt(T));
-  const double term2 =
+  const Real term1 = S * std::exp(-q * T) * one_over_sqrt_two_pi *
+                     std::exp(-d1 * d1 / Real(2)) * sigma /
+                     (Real(2) * std::sqrt(T));
+  const Real term2 =
       r * K * std::exp(-r * T) *
       normal((option.getType() == OptionType::Call) ? d2 : -d2);
-  const double term3 =
+  const Real term3 =
       q * S * std::exp(-q * T) *
       normal((option.getType() == OptionType::Call) ? d1 : -d1);
 
@@ -231,10 +227,11 @@ double BlackScholes::theta(const EuropeanOption &option) {
   return -term1 + term2 - term3;
 }
 
-double BlackScholes::rho(const EuropeanOption &option) {
-  const double K = option.getStrikePrice();
-  const double r = option.getRiskFreeRate();
-  const double T = option.getMaturity();
+template <typename Real>
+Real BlackScholes::rho(const BasicEuropeanOption<Real> &option) {
+  const Real K = option.getStrikePrice();
+  const Real r = option.getRiskFreeRate();
+  const Real T = option.getMaturity();
 
   if (K <= 0.0) {
     throw std::invalid_argument(
@@ -249,10 +246,154 @@ double BlackScholes::rho(const EuropeanOption &option) {
         ErrorMessages::BlackScholes::kInvalidTimeToMaturity);
   }
 
-  const double d2 = calculate_d2(option); // Could potentially throw
+  const Real d2 = calculate_d2(option); // Could potentially throw
 
   if (option.getType() == OptionType::Call) {
     return K * T * std::exp(-r * T) * normal(d2);
   }
   return -K * T * std::exp(-r * T) * normal(-d2);
+}
+
+template <typename Real>
+void BlackScholes::priceBatch(
+    const std::vector<BasicEuropeanOption<Real>> &options, Real *prices) {
+  const size_t n = options.size();
+  for (size_t i = 0; i < n; ++i) {
+    const BasicEuropeanOption<Real> &option = options[i];
+    const Real S = option.getSpotPriceImpl();
+    const Real K = option.getStrikePriceImpl();
+    const Real r = option.getRiskFreeRateImpl();
+    const Real q = option.getDividendYieldImpl();
+    const Real T = option.getMaturityImpl();
+    const Real sigma = option.getVolatilityImpl();
+
+    // w = +1 for calls and -1 for puts folds both payoffs into one formula
+    const Real w =
+        option.getTypeImpl() == OptionType::Call ? Real(1) : Real(-1);
+    const Real volSqrtT = sigma * std::sqrt(T);
+    const Real d1 =
+        (std::log(S / K) + (r - q + Real(0.5) * sigma * sigma) * T) / volSqrtT;
+    const Real d2 = d1 - volSqrtT;
+
+    prices[i] = w * (S * std::exp(-q * T) * normal(w * d1) -
+                     K * std::exp(-r * T) * normal(w * d2));
+  }
+}
+
+template <typename Real>
+void BlackScholes::greeksBatch(
+    const std::vector<BasicEuropeanOption<Real>> &options,
+    BasicGreeks<Real> *greeks) {
+  const size_t n = options.size();
+  for (size_t i = 0; i < n; ++i) {
+    const BasicEuropeanOption<Real> &option = options[i];
+    const Real S = option.getSpotPriceImpl();
+    const Real K = option.getStrikePriceImpl();
+    const Real r = option.getRiskFreeRateImpl();
+    const Real q = option.getDividendYieldImpl();
+    const Real T = option.getMaturityImpl();
+    const Real sigma = option.getVolatilityImpl();
+
+    const Real w =
+        option.getTypeImpl() == OptionType::Call ? Real(1) : Real(-1);
+    const Real sqrtT = std::sqrt(T);
+    const Real volSqrtT = sigma * sqrtT;
+    const Real d1 =
+        (std::log(S / K) + (r - q + Real(0.5) * sigma * sigma) * T) / volSqrtT;
+    const Real d2 = d1 - volSqrtT;
+    const Real dividendDiscount = std::exp(-q * T);
+    const Real spotDiscount = S * dividendDiscount;
+    const Real strikeDiscount = K * std::exp(-r * T);
+    const Real density = NumericalMethods::normalPdf(d1);
+    const Real n1 = normal(w * d1);
+    const Real n2 = normal(w * d2);
+
+    greeks[i] = {w * (spotDiscount * n1 - strikeDiscount * n2),
+                 w * dividendDiscount * n1,
+                 dividendDiscount * density / (S * volSqrtT),
+                 spotDiscount * sqrtT * density,
+                 -spotDiscount * density * sigma / (Real(2) * sqrtT) -
+                     w * r * strikeDiscount * n2 +
+                     w * q * spotDiscount * n1,
+                 w * T * strikeDiscount * n2};
+  }
+}
+
+template float BlackScholes::price(const BasicEuropeanOption<float> &);
+template double BlackScholes::price(const BasicEuropeanOption<double> &);
+template float BlackScholes::delta(const BasicEuropeanOption<float> &);
+template double BlackScholes::delta(const BasicEuropeanOption<double> &);
+template float BlackScholes::gamma(const BasicEuropeanOption<float> &);
+template double BlackScholes::gamma(const BasicEuropeanOption<double> &);
+template float BlackScholes::vega(const BasicEuropeanOption<float> &);
+template double BlackScholes::vega(const BasicEuropeanOption<double> &);
+template float BlackScholes::theta(const BasicEuropeanOption<float> &);
+template double BlackScholes::theta(const BasicEuropeanOption<double> &);
+template float BlackScholes::rho(const BasicEuropeanOption<float> &);
+template double BlackScholes::rho(const BasicEuropeanOption<double> &);
+template void
+BlackScholes::priceBatch(const std::vector<BasicEuropeanOption<float>> &,
+                         float *);
+template void
+BlackScholes::priceBatch(const std::vector<BasicEuropeanOption<double>> &,
+                         double *);
+template void
+BlackScholes::greeksBatch(const std::vector<BasicEuropeanOption<float>> &,
+                          BasicGreeks<float> *);
+template void
+BlackScholes::greeksBatch(const std::vector<BasicEuropeanOption<double>> &,
+                          BasicGreeks<double> *);
+
+EuropeanOption
+BlackScholes::adjustForTermStructure(const EuropeanOption &option,
+                                     const YieldCurve &curve,
+                                     const DividendSchedule &dividends) {
+  const double T = option.getMaturity();
+  if (T <= 0.0) {
+    throw std::invalid_argument(
+        ErrorMessages::BlackScholes::kInvalidTimeToMaturity);
+  }
+
+  EuropeanOption adjusted(
+      option.getSpotPrice() - dividends.presentValue(curve, 0.0, T),
+      option.getStrikePrice(), curve.zeroRate(T), T,
+      option.getVolatilityImpl(), option.getType(), option.getDividendYield());
+  return adjusted;
+}
+
+double BlackScholes::price(const EuropeanOption &option,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return price(adjustForTermStructure(option, curve, dividends));
+}
+
+double BlackScholes::delta(const EuropeanOption &option,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  // the escrowed spot moves one for one with the quoted spot
+  return delta(adjustForTermStructure(option, curve, dividends));
+}
+
+double BlackScholes::gamma(const EuropeanOption &option,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return gamma(adjustForTermStructure(option, curve, dividends));
+}
+
+double BlackScholes::vega(const EuropeanOption &option,
+                          const YieldCurve &curve,
+                          const DividendSchedule &dividends) {
+  return vega(adjustForTermStructure(option, curve, dividends));
+}
+
+double BlackScholes::theta(const EuropeanOption &option,
+                           const YieldCurve &curve,
+                           const DividendSchedule &dividends) {
+  return theta(adjustForTermStructure(option, curve, dividends));
+}
+
+double BlackScholes::rho(const EuropeanOption &option,
+                         const YieldCurve &curve,
+                         const DividendSchedule &dividends) {
+  return rho(adjustForTermStructure(option, curve, dividends));
 }
\ No newline at end of file
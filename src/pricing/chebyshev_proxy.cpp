@@ -0,0 +1,355 @@
+#include "pricing/chebyshev_proxy.h"
+#include "error_messages.h"
+#include "pricing/binomial_tree.h"
+#include "utils/parallel.h"
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+  constexpr double kPi = 3.14159265358979323846;
+  constexpr std::uint32_t kFileMagic = 0x59585250; // "PRXY"
+  constexpr std::uint32_t kFileVersion = 1;
+
+  // i-th of n Chebyshev roots, mapped onto [lo, hi]
+  double chebyshevNode(const int &i, const int &n, const double &lo,
+                       const double &hi) {
+    const double x = std::cos(kPi * (i + 0.5) / n);
+    return 0.5 * (lo + hi) + 0.5 * (hi - lo) * x;
+  }
+
+  // T_0(x) .. T_{n-1}(x)
+  void chebyshevBasis(const double &x, const int &n, double *basis) {
+    basis[0] = 1.0;
+    if (n > 1) {
+      basis[1] = x;
+    }
+    for (int k = 2; k < n; ++k) {
+      basis[k] = 2.0 * x * basis[k - 1] - basis[k - 2];
+    }
+  }
+
+  // [lo, hi] -> [-1, 1]
+  double toUnit(const double &v, const double &lo, const double &hi) {
+    return (2.0 * v - lo - hi) / (hi - lo);
+  }
+
+  // In place: values at the n Chebyshev roots along one axis of a tensor
+  // become coefficients, with c_0 pre-halved so the series needs no special
+  // case. `stride` is the distance between consecutive entries of
+  // the axis and `starts` holds the first entry of every line along it.
+  void transformAxis(double *data, const int &n, const size_t &stride,
+                     const std::vector<size_t> &starts) {
+    std::vector<double> line(n);
+    for (const size_t start : starts) {
+      for (int j = 0; j < n; ++j) {
+        line[j] = data[start + j * stride];
+      }
+      for (int k = 0; k < n; ++k) {
+        double sum = 0.0;
+        for (int j = 0; j < n; ++j) {
+          sum += line[j] * std::cos(kPi * k * (j + 0.5) / n);
+        }
+        data[start + k * stride] = (k == 0 ? 1.0 : 2.0) * sum / n;
+      }
+    }
+  }
+
+  template <typename T> void write(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T> T read(std::istream &in) {
+    T value;
+    if (!in.read(reinterpret_cast<char *>(&value), sizeof(T))) {
+      throw std::runtime_error(ErrorMessages::Proxy::kCorruptFile);
+    }
+    return value;
+  }
+
+} // namespace
+
+ChebyshevProxy::ChebyshevProxy(const ProxyConfig &config,
+                               const std::vector<ProxyBucket> &buckets)
+    : config_(config), buckets_(buckets),
+      coefficients_(buckets.size() * kTables * tableSize(), 0.0) {}
+
+void ChebyshevProxy::validate(const ProxyConfig &config) {
+  const ProxyBox &box = config.box;
+  if (!(box.moneynessMin > 0.0 && box.moneynessMin < box.moneynessMax &&
+        box.volMin > 0.0 && box.volMin < box.volMax &&
+        box.maturityMin > 0.0 && box.maturityMin < box.maturityMax)) {
+    throw std::invalid_argument(ErrorMessages::Proxy::kInvalidBox);
+  }
+  if (config.moneynessNodes <= 0 || config.volNodes <= 0 ||
+      config.maturityNodes <= 0 || config.moneynessNodes > kMaxNodes ||
+      config.volNodes > kMaxNodes || config.maturityNodes > kMaxNodes) {
+    throw std::invalid_argument(ErrorMessages::Proxy::kInvalidNodes);
+  }
+  if (config.numSteps <= 0) {
+    throw std::invalid_argument(ErrorMessages::BinomialTree::kInvalidNumSteps);
+  }
+}
+
+size_t ChebyshevProxy::tableSize() const {
+  return static_cast<size_t>(config_.moneynessNodes) * config_.volNodes *
+         config_.maturityNodes;
+}
+
+const double *ChebyshevProxy::table(const size_t &bucket,
+                                    const Table &kind) const {
+  return coefficients_.data() + (bucket * kTables + kind) * tableSize();
+}
+
+ChebyshevProxy ChebyshevProxy::build(const ProxyConfig &config,
+                                     const std::vector<ProxyBucket> &buckets,
+                                     const unsigned &threads) {
+  validate(config);
+  ChebyshevProxy proxy(config, buckets);
+  const ProxyBox &box = config.box;
+  const int nm = config.moneynessNodes;
+  const int nv = config.volNodes;
+  const int nt = config.maturityNodes;
+  const size_t size = proxy.tableSize();
+
+  // one work item per (bucket, node): nine lattices for the four tables
+  Parallel::forEach(
+      buckets.size() * size,
+      [&](const size_t item) {
+        const size_t bucket = item / size;
+        const size_t node = item % size;
+        const int i = static_cast<int>(node / (nv * nt));
+        const int j = static_cast<int>(node / nt % nv);
+        const int k = static_cast<int>(node % nt);
+        const AmericanOption option(
+            chebyshevNode(i, nm, box.moneynessMin, box.moneynessMax), 1.0,
+            buckets[bucket].riskFreeRate,
+            chebyshevNode(k, nt, box.maturityMin, box.maturityMax),
+            chebyshevNode(j, nv, box.volMin, box.volMax), buckets[bucket].type,
+            buckets[bucket].dividendYield);
+        double *values = proxy.coefficients_.data() + bucket * kTables * size;
+        values[kPrice * size + node] =
+            BinomialTree::price(option, config.numSteps);
+        values[kDelta * size + node] =
+            BinomialTree::delta(option, config.numSteps);
+        values[kGamma * size + node] =
+            BinomialTree::gamma(option, config.numSteps);
+        values[kTheta * size + node] =
+            BinomialTree::theta(option, config.numSteps);
+      },
+      threads);
+
+  // separable transform, one axis at a time
+  std::vector<size_t> maturityLines;
+  std::vector<size_t> volLines;
+  std::vector<size_t> moneynessLines;
+  for (int i = 0; i < nm; ++i) {
+    for (int j = 0; j < nv; ++j) {
+      maturityLines.push_back(static_cast<size_t>(i * nv + j) * nt);
+    }
+    for (int k = 0; k < nt; ++k) {
+      volLines.push_back(static_cast<size_t>(i * nv) * nt + k);
+    }
+  }
+  for (int jk = 0; jk < nv * nt; ++jk) {
+    moneynessLines.push_back(jk);
+  }
+  for (size_t t = 0; t < buckets.size() * kTables; ++t) {
+    double *data = proxy.coefficients_.data() + t * size;
+    transformAxis(data, nt, 1, maturityLines);
+    transformAxis(data, nv, nt, volLines);
+    transformAxis(data, nm, static_cast<size_t>(nv) * nt, moneynessLines);
+  }
+  return proxy;
+}
+
+size_t ChebyshevProxy::find(const AmericanOption &option) const {
+  const ProxyBox &box = config_.box;
+  const double moneyness = option.getSpotPrice() / option.getStrikePrice();
+  const double sigma = option.getVolatility();
+  const double T = option.getMaturity();
+  if (!(moneyness >= box.moneynessMin && moneyness <= box.moneynessMax &&
+        sigma >= box.volMin && sigma <= box.volMax && T >= box.maturityMin &&
+        T <= box.maturityMax)) {
+    return buckets_.size();
+  }
+  for (size_t b = 0; b < buckets_.size(); ++b) {
+    if (buckets_[b].riskFreeRate == option.getRiskFreeRate() &&
+        buckets_[b].dividendYield == option.getDividendYield() &&
+        buckets_[b].type == option.getType()) {
+      return b;
+    }
+  }
+  return buckets_.size();
+}
+
+bool ChebyshevProxy::covers(const AmericanOption &option) const {
+  return option.getStrikePrice() > 0.0 && find(option) < buckets_.size();
+}
+
+double ChebyshevProxy::evaluate(const double *coefficients,
+                                const AmericanOption &option) const {
+  const ProxyBox &box = config_.box;
+  const int nm = config_.moneynessNodes;
+  const int nv = config_.volNodes;
+  const int nt = config_.maturityNodes;
+  double tx[kMaxNodes];
+  double ty[kMaxNodes];
+  double tz[kMaxNodes];
+  chebyshevBasis(toUnit(option.getSpotPrice() / option.getStrikePrice(),
+                        box.moneynessMin, box.moneynessMax),
+                 nm, tx);
+  chebyshevBasis(toUnit(option.getVolatility(), box.volMin, box.volMax), nv,
+                 ty);
+  chebyshevBasis(
+      toUnit(option.getMaturity(), box.maturityMin, box.maturityMax), nt, tz);
+
+  // Clenshaw's recurrence would be one serial dependency chain through
+  // every coefficient; contracting against the basis values instead leaves
+  // independent dot products over contiguous maturity rows
+  double sum = 0.0;
+  for (int i = 0; i < nm; ++i) {
+    double row = 0.0;
+    for (int j = 0; j < nv; ++j) {
+      const double *c = coefficients + static_cast<size_t>(i * nv + j) * nt;
+      double dot = 0.0;
+      for (int k = 0; k < nt; ++k) {
+        dot += c[k] * tz[k];
+      }
+      row += dot * ty[j];
+    }
+    sum += row * tx[i];
+  }
+  return sum;
+}
+
+double ChebyshevProxy::price(const AmericanOption &option) const {
+  const size_t bucket = find(option);
+  if (bucket == buckets_.size()) {
+    return BinomialTree::price(option, config_.numSteps);
+  }
+  return option.getStrikePrice() * evaluate(table(bucket, kPrice), option);
+}
+
+double ChebyshevProxy::delta(const AmericanOption &option) const {
+  const size_t bucket = find(option);
+  if (bucket == buckets_.size()) {
+    return BinomialTree::delta(option, config_.numSteps);
+  }
+  return evaluate(table(bucket, kDelta), option);
+}
+
+double ChebyshevProxy::gamma(const AmericanOption &option) const {
+  const size_t bucket = find(option);
+  if (bucket == buckets_.size()) {
+    return BinomialTree::gamma(option, config_.numSteps);
+  }
+  return evaluate(table(bucket, kGamma), option) / option.getStrikePrice();
+}
+
+double ChebyshevProxy::theta(const AmericanOption &option) const {
+  const size_t bucket = find(option);
+  if (bucket == buckets_.size()) {
+    return BinomialTree::theta(option, config_.numSteps);
+  }
+  return option.getStrikePrice() * evaluate(table(bucket, kTheta), option);
+}
+
+ProxyErrorEstimate ChebyshevProxy::errorEstimate(const size_t &bucket) const {
+  const int nm = config_.moneynessNodes;
+  const int nv = config_.volNodes;
+  const int nt = config_.maturityNodes;
+  double tails[kTables] = {};
+  for (int t = 0; t < kTables; ++t) {
+    const double *c = table(bucket, static_cast<Table>(t));
+    for (int i = 0; i < nm; ++i) {
+      for (int j = 0; j < nv; ++j) {
+        for (int k = 0; k < nt; ++k) {
+          if (i == nm - 1 || j == nv - 1 || k == nt - 1) {
+            tails[t] += std::abs(c[static_cast<size_t>(i * nv + j) * nt + k]);
+          }
+        }
+      }
+    }
+  }
+  return {tails[kPrice], tails[kDelta], tails[kGamma], tails[kTheta]};
+}
+
+void ChebyshevProxy::save(const std::string &path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error(ErrorMessages::Proxy::kUnwritableFile);
+  }
+  write(out, kFileMagic);
+  write(out, kFileVersion);
+  write(out, config_.box);
+  write(out, static_cast<std::int32_t>(config_.moneynessNodes));
+  write(out, static_cast<std::int32_t>(config_.volNodes));
+  write(out, static_cast<std::int32_t>(config_.maturityNodes));
+  write(out, static_cast<std::int32_t>(config_.numSteps));
+  write(out, static_cast<std::uint64_t>(buckets_.size()));
+  for (const ProxyBucket &bucket : buckets_) {
+    write(out, bucket.riskFreeRate);
+    write(out, bucket.dividendYield);
+    write(out, static_cast<std::int32_t>(bucket.type));
+  }
+  out.write(reinterpret_cast<const char *>(coefficients_.data()),
+            static_cast<std::streamsize>(coefficients_.size() *
+                                         sizeof(double)));
+  if (!out) {
+    throw std::runtime_error(ErrorMessages::Proxy::kUnwritableFile);
+  }
+}
+
+ChebyshevProxy ChebyshevProxy::load(const std::string &path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw std::runtime_error(ErrorMessages::Proxy::kUnreadableFile);
+  }
+  const auto fileSize = static_cast<std::uint64_t>(in.tellg());
+  in.seekg(0);
+  if (read<std::uint32_t>(in) != kFileMagic ||
+      read<std::uint32_t>(in) != kFileVersion) {
+    throw std::runtime_error(ErrorMessages::Proxy::kCorruptFile);
+  }
+  ProxyConfig config;
+  config.box = read<ProxyBox>(in);
+  config.moneynessNodes = read<std::int32_t>(in);
+  config.volNodes = read<std::int32_t>(in);
+  config.maturityNodes = read<std::int32_t>(in);
+  config.numSteps = read<std::int32_t>(in);
+  try {
+    validate(config);
+  } catch (const std::invalid_argument &) {
+    throw std::runtime_error(ErrorMessages::Proxy::kCorruptFile);
+  }
+
+  // checked against the file size before anything is allocated
+  const auto count = read<std::uint64_t>(in);
+  const std::uint64_t bucketBytes =
+      sizeof(double) * (2 + kTables * static_cast<std::uint64_t>(
+                                          config.moneynessNodes) *
+                                          config.volNodes *
+                                          config.maturityNodes) +
+      sizeof(std::int32_t);
+  if (count > (fileSize - static_cast<std::uint64_t>(in.tellg())) /
+                  bucketBytes) {
+    throw std::runtime_error(ErrorMessages::Proxy::kCorruptFile);
+  }
+  std::vector<ProxyBucket> buckets(count);
+  for (ProxyBucket &bucket : buckets) {
+    bucket.riskFreeRate = read<double>(in);
+    bucket.dividendYield = read<double>(in);
+    bucket.type = static_cast<OptionType>(read<std::int32_t>(in));
+  }
+  ChebyshevProxy proxy(config, buckets);
+  const auto bytes =
+      static_cast<std::streamsize>(proxy.coefficients_.size() * sizeof(double));
+  if (!in.read(reinterpret_cast<char *>(proxy.coefficients_.data()), bytes) ||
+      in.peek() != std::ifstream::traits_type::eof()) {
+    throw std::runtime_error(ErrorMessages::Proxy::kCorruptFile);
+  }
+  return proxy;
+}
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include "pricing/heston.h"
+#include "error_messages.h"
+#include "utils/numerical_methods.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+  using Complex = std::complex<double>;
+
+  constexpr double kPi = 3.14159265358979323846;
+  constexpr int kIntegrationNodes = 256;
+
+  // shared by every contract of a strip
+  struct Market {
+    double S;
+    double r;
+    double q;
+    double T;
+  };
+
+  // characteristic function of ln(S_T / S_0), drift included
+  Complex logReturnCf(const Complex &u, const Market &m,
+                      const HestonParameters &p) {
+    return std::exp(Complex(0.0, 1.0) * u * ((m.r - m.q) * m.T)) *
+           Heston::characteristicFunction(u, m.T, p);
+  }
+
+  // Mean and variance of ln(S_T / S_0). With I = int_0^T v dt and
+  // M = int_0^T sqrt(v) dW, ln(S_T / S_0) = (r - q) T - I / 2 + M, so the
+  // variance is E[I] - Cov(I, M) + Var(I) / 4; the two moments of I follow
+  // from v_t = E[v_t] + volOfVol int_0^t e^{-kappa (t - s)} sqrt(v_s) dZ_s.
+  void cumulants(const Market &m, const HestonParameters &p, double &c1,
+                 double &c2) {
+    const double k = p.kappa;
+    const double T = m.T;
+    const double E = std::exp(-k * T);
+    const double excess = p.v0 - p.theta;
+    const double meanI = p.theta * T + excess * (1.0 - E) / k;
+    const double covIM =
+        p.volOfVol * p.rho / k *
+        (p.theta * (T - (1.0 - E) / k) + excess * ((1.0 - E) / k - T * E));
+    const double varI =
+        p.volOfVol * p.volOfVol / (k * k) *
+        (p.theta * (T - 2.0 * (1.0 - E) / k + (1.0 - E * E) / (2.0 * k)) +
+         excess * ((1.0 - E) / k - 2.0 * T * E + (E - E * E) / k));
+    c1 = (m.r - m.q) * T - 0.5 * meanI;
+    c2 = meanI - covIM + 0.25 * varI;
+  }
+
+  // Puts for every strike of the strip, at once. With y = ln(S_T / K) on
+  // [a, b] and u_k = k pi / (b - a),
+  //   P_j = K_j e^{-rT} sum'_k Re[phi(u_k) e^{i u_k (x_j - a)}] U_k
+  // where x_j = ln(S / K_j) and U_k are the cosine coefficients of the unit
+  // put payoff. phi(u_k) e^{-i u_k a} U_k does not depend on the strike and
+  // is computed once.
+  void cosPuts(const Market &m, const std::vector<double> &strikes,
+               const HestonParameters &p, const StripConfig &config,
+               double *puts) {
+    const size_t n = strikes.size();
+    std::vector<double> x(n);
+    double xMin = 0.0;
+    double xMax = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+      x[j] = std::log(m.S / strikes[j]);
+      xMin = j == 0 ? x[j] : std::min(xMin, x[j]);
+      xMax = j == 0 ? x[j] : std::max(xMax, x[j]);
+    }
+    double c1 = 0.0;
+    double c2 = 0.0;
+    cumulants(m, p, c1, c2);
+    const double width = config.cosTruncation * std::sqrt(std::abs(c2));
+    const double a = c1 + xMin - width;
+    const double b = c1 + xMax + width;
+    const double d = std::min(b, 0.0); // the put pays on [a, min(b, 0)]
+
+    // strike-independent terms, split into real and imaginary parts
+    const int terms = config.cosTerms;
+    std::vector<double> fr(terms, 0.0);
+    std::vector<double> fi(terms, 0.0);
+    if (d > a) {
+      for (int k = 0; k < terms; ++k) {
+        const double w = k * kPi / (b - a);
+        const double chi = (std::cos(w * (d - a)) * std::exp(d) - std::exp(a) +
+                            w * std::sin(w * (d - a)) * std::exp(d)) /
+                           (1.0 + w * w);
+        const double psi = k == 0 ? d - a : std::sin(w * (d - a)) / w;
+        const double U = (k == 0 ? 0.5 : 1.0) * 2.0 / (b - a) * (psi - chi);
+        const Complex f = logReturnCf(w, m, p) * std::polar(U, -w * a);
+        fr[k] = f.real();
+        fi[k] = f.imag();
+      }
+    }
+
+    // e^{i u_k x_j} advanced by one rotation per term; the loop over strikes
+    // is contiguous split-complex arithmetic and vectorizes
+    std::vector<double> cr(n, 1.0);
+    std::vector<double> ci(n, 0.0);
+    std::vector<double> sr(n);
+    std::vector<double> si(n);
+    std::vector<double> sum(n, 0.0);
+    for (size_t j = 0; j < n; ++j) {
+      sr[j] = std::cos(kPi * x[j] / (b - a));
+      si[j] = std::sin(kPi * x[j] / (b - a));
+    }
+    for (int k = 0; k < terms; ++k) {
+      const double re = fr[k];
+      const double im = fi[k];
+      for (size_t j = 0; j < n; ++j) {
+        sum[j] += re * cr[j] - im * ci[j];
+        const double rotated = cr[j] * sr[j] - ci[j] * si[j];
+        ci[j] = cr[j] * si[j] + ci[j] * sr[j];
+        cr[j] = rotated;
+      }
+    }
+    const double discount = std::exp(-m.r * m.T);
+    for (size_t j = 0; j < n; ++j) {
+      puts[j] = std::max(strikes[j] * discount * sum[j], 0.0);
+    }
+  }
+
+  // Calls for every strike of the strip from one transform (Carr and Madan
+  // 1999) of the damped call price over the log-strike grid
+  // k_u = -N lambda / 2 + lambda u, for a unit spot; strikes between grid
+  // points are interpolated with cubics.
+  void carrMadanCalls(const Market &m, const std::vector<double> &strikes,
+                      const HestonParameters &p, const StripConfig &config,
+                      double *calls) {
+    const int N = config.fftPoints;
+    const double eta = config.fftSpacing;
+    const double alpha = config.damping;
+    const double lambda = 2.0 * kPi / (N * eta);
+    const double kMin = -0.5 * N * lambda;
+    const double discount = std::exp(-m.r * m.T);
+
+    std::vector<Complex> data(N);
+    for (int j = 0; j < N; ++j) {
+      const double v = eta * j;
+      const Complex psi =
+          discount * logReturnCf(Complex(v, -(alpha + 1.0)), m, p) /
+          Complex(alpha * alpha + alpha - v * v, (2.0 * alpha + 1.0) * v);
+      // Simpson weights, and e^{-i v kMin} = (-1)^j
+      const double simpson = (j == 0 ? 1.0 : (j % 2 == 1 ? 4.0 : 2.0)) / 3.0;
+      data[j] = (j % 2 == 0 ? 1.0 : -1.0) * psi * eta * simpson;
+    }
+    NumericalMethods::fft(data);
+
+    for (size_t s = 0; s < strikes.size(); ++s) {
+      const double k = std::log(strikes[s] / m.S);
+      const double position = (k - kMin) / lambda;
+      const int first = std::max(
+          0, std::min(N - 4, static_cast<int>(std::floor(position)) - 1));
+      double value = 0.0;
+      for (int i = 0; i < 4; ++i) {
+        double weight = 1.0;
+        for (int l = 0; l < 4; ++l) {
+          if (l != i) {
+            weight *= (position - (first + l)) / static_cast<double>(i - l);
+          }
+        }
+        const double ku = kMin + lambda * (first + i);
+        value += weight * std::exp(-alpha * ku) / kPi * data[first + i].real();
+      }
+      calls[s] = std::max(m.S * value, 0.0);
+    }
+  }
+
+} // namespace
+
+Complex Heston::characteristicFunction(const Complex &u, const double &T,
+                                       const HestonParameters &params) {
+  const Complex i(0.0, 1.0);
+  const double s2 = params.volOfVol * params.volOfVol;
+  const Complex beta = params.kappa - params.rho * params.volOfVol * i * u;
+  const Complex d = std::sqrt(beta * beta + s2 * (i * u + u * u));
+  const Complex g = (beta - d) / (beta + d);
+  const Complex e = std::exp(-d * T);
+  const Complex C =
+      params.kappa * params.theta / s2 *
+      ((beta - d) * T - 2.0 * std::log((1.0 - g * e) / (1.0 - g)));
+  const Complex D = (beta - d) / s2 * (1.0 - e) / (1.0 - g * e);
+  return std::exp(C + D * params.v0);
+}
+
+void Heston::validate(const EuropeanOption &option) {
+  if (option.getSpotPrice() <= 0.0) {
+    throw std::invalid_argument(ErrorMessages::BlackScholes::kInvalidSpotPrice);
+  }
+  if (option.getStrikePrice() <= 0.0) {
+    throw std::invalid_argument(
+        ErrorMessages::BlackScholes::kInvalidStrikePrice);
+  }
+  if (option.getRiskFreeRate() < 0.0) {
+    throw std::invalid_argument(
+        ErrorMessages::BlackScholes::kInvalidRiskFreeRate);
+  }
+  if (option.getMaturity() <= 0.0) {
+    throw std::invalid_argument(
+        ErrorMessages::BlackScholes::kInvalidTimeToMaturity);
+  }
+}
+
+void Heston::validate(const HestonParameters &params) {
+  if (!(params.v0 >= 0.0 && params.theta >= 0.0 && params.kappa > 0.0 &&
+        params.volOfVol > 0.0 && std::abs(params.rho) <= 1.0)) {
+    throw std::invalid_argument(ErrorMessages::Heston::kInvalidParameters);
+  }
+}
+
+// Lewis (2001):
+//   C = S e^{-qT} - sqrt(S K) e^{-(r+q)T/2} / pi
+//       * int_0^inf Re[e^{iuk} phi(u - i/2)] / (u^2 + 1/4) du
+// with k = ln(S / K) + (r - q) T, integrated over u = c t / (1 - t) with c
+// the inverse of the expected terminal standard deviation.
+double Heston::price(const EuropeanOption &option,
+                     const HestonParameters &params) {
+  validate(option);
+  validate(params);
+  const double S = option.getSpotPrice();
+  const double K = option.getStrikePrice();
+  const double r = option.getRiskFreeRate();
+  const double q = option.getDividendYield();
+  const double T = option.getMaturity();
+
+  static const QuadratureRule rule =
+      NumericalMethods::gaussLegendre(kIntegrationNodes);
+  const double meanVariance =
+      params.theta + (params.v0 - params.theta) *
+                         -std::expm1(-params.kappa * T) / (params.kappa * T);
+  const double scale = 1.0 / std::sqrt(std::max(meanVariance, 1e-4) * T);
+  const double k = std::log(S / K) + (r - q) * T;
+
+  double integral = 0.0;
+  for (size_t n = 0; n < rule.nodes.size(); ++n) {
+    const double t = 0.5 * (rule.nodes[n] + 1.0);
+    const double u = scale * t / (1.0 - t);
+    const double du = scale / ((1.0 - t) * (1.0 - t));
+    const Complex phi = characteristicFunction(Complex(u, -0.5), T, params);
+    integral += 0.5 * rule.weights[n] * du *
+                (std::polar(1.0, u * k) * phi).real() / (u * u + 0.25);
+  }
+  const double call = S * std::exp(-q * T) -
+                      std::sqrt(S * K) * std::exp(-0.5 * (r + q) * T) / kPi *
+                          integral;
+  if (option.getType() == OptionType::Call) {
+    return call;
+  }
+  return call - S * std::exp(-q * T) + K * std::exp(-r * T);
+}
+
+void Heston::priceStrip(const std::vector<EuropeanOption> &strip,
+                        const HestonParameters &params, double *prices,
+                        const StripMethod &method, const StripConfig &config) {
+  validate(params);
+  if (config.cosTerms <= 0 || !(config.cosTruncation > 0.0) ||
+      config.fftPoints < 4 || (config.fftPoints & (config.fftPoints - 1)) ||
+      !(config.fftSpacing > 0.0) || !(config.damping > 0.0)) {
+    throw std::invalid_argument(ErrorMessages::Heston::kInvalidStripConfig);
+  }
+  if (strip.empty()) {
+    return;
+  }
+  const Market m{strip[0].getSpotPrice(), strip[0].getRiskFreeRate(),
+                 strip[0].getDividendYield(), strip[0].getMaturity()};
+  std::vector<double> strikes(strip.size());
+  for (size_t j = 0; j < strip.size(); ++j) {
+    const EuropeanOption &option = strip[j];
+    validate(option);
+    if (option.getSpotPrice() != m.S || option.getRiskFreeRate() != m.r ||
+        option.getDividendYield() != m.q || option.getMaturity() != m.T) {
+      throw std::invalid_argument(ErrorMessages::Heston::kMixedStrip);
+    }
+    strikes[j] = option.getStrikePrice();
+  }
+
+  // COS is stable for puts, Carr-Madan is stated for calls; the other side
+  // follows from parity
+  const bool puts = method == StripMethod::Cos;
+  if (puts) {
+    cosPuts(m, strikes, params, config, prices);
+  } else {
+    carrMadanCalls(m, strikes, params, config, prices);
+  }
+  const double prepaidForward = m.S * std::exp(-m.q * m.T);
+  const double discount = std::exp(-m.r * m.T);
+  for (size_t j = 0; j < strip.size(); ++j) {
+    const bool call = strip[j].getType() == OptionType::Call;
+    if (call == puts) {
+      const double parity = prepaidForward - strikes[j] * discount;
+      prices[j] += puts ? parity : -parity;
+    }
+  }
+}
\ No newline at end of file
@@ -1,11 +1,18 @@
 #include "pricing/implied_vol.h"
 #include "error_messages.h"
+#include "pricing/analytic_american.h"
+#include "pricing/binomial_tree.h"
 #include "pricing/black_scholes.h"
 #include "utils/numerical_methods.h"
+#include "utils/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 double ImpliedVolatility::calculateImpliedVolatility(
     const EuropeanOption &option, const double &marketPrice,
-    const double &tolerance, const int &maxIterations) {
+    const double &tolerance, const int &maxIterations,
+    const double &initialGuess) {
   if (marketPrice <= 0.0) {
     throw std::invalid_argument(ErrorMessages::ImpliedVol::kInvalidMarketPrice);
   }
@@ -23,11 +30,276 @@ double ImpliedVolatility::calculateImpliedVolatility(
   };
 
   try {
-    constexpr double initialGuess = 0.2; // TODO: fine-tuned
     return NumericalMethods::newtonRaphson(f, fprime, initialGuess, tolerance,
                                            maxIterations);
   } catch (const std::runtime_error &e) {
     throw std::runtime_error("ImpliedVolatility calculation failed: " +
                              std::string(e.what()));
   }
+}
+
+namespace {
+
+  // keeps the at-the-money inflection point, zero, off the boundary
+  constexpr double kMinInflection = 1e-2;
+
+  // Per-quote constants of a European strip; the price at sigma is
+  // sign * (spotDiscount N(sign d1) - strikeDiscount N(sign d2)) with
+  // d1 = drift / (sigma sqrtT) + sigma sqrtT / 2.
+  struct StripTerms {
+    std::vector<double> sign;
+    std::vector<double> drift;
+    std::vector<double> sqrtT;
+    std::vector<double> spotDiscount;
+    std::vector<double> strikeDiscount;
+    std::vector<double> target;
+    std::vector<double> inflection;
+  };
+
+  // Up to maxIterations Newton sweeps over the quotes in `active`, starting
+  // from sigma. Converged quotes are written to vols; the ones that failed
+  // are returned, in order.
+  std::vector<size_t> newtonSweeps(const StripTerms &terms,
+                                   std::vector<size_t> active,
+                                   std::vector<double> &sigma,
+                                   const double &tolerance,
+                                   const int &maxIterations, double *vols) {
+    std::vector<size_t> failed;
+    for (int iteration = 0; iteration < maxIterations && !active.empty();
+         ++iteration) {
+      size_t kept = 0;
+      for (const size_t &i : active) {
+        const double s = sigma[i];
+        const double w = terms.sign[i];
+        const double volSqrtT = s * terms.sqrtT[i];
+        const double d1 = terms.drift[i] / volSqrtT + 0.5 * volSqrtT;
+        const double d2 = d1 - volSqrtT;
+        const double residual =
+            w * (terms.spotDiscount[i] *
+                     NumericalMethods::normalCdf(w * d1) -
+                 terms.strikeDiscount[i] *
+                     NumericalMethods::normalCdf(w * d2)) -
+            terms.target[i];
+        if (std::abs(residual) < tolerance) {
+          vols[i] = s;
+          continue;
+        }
+        const double vega = terms.spotDiscount[i] * terms.sqrtT[i] *
+                            NumericalMethods::normalPdf(d1);
+        const double next = s - residual / vega;
+        // the same exits as NumericalMethods::newtonRaphson on
+        // BlackScholes::price, which throws on a non-positive volatility
+        if (vega < 1e-15 || !(next > 0.0) || !std::isfinite(next)) {
+          failed.push_back(i);
+          continue;
+        }
+        sigma[i] = next;
+        active[kept++] = i;
+      }
+      active.resize(kept);
+    }
+    failed.insert(failed.end(), active.begin(), active.end());
+    std::sort(failed.begin(), failed.end());
+    return failed;
+  }
+
+  // One safeguarded Newton update on residual(sigma) = model - quote. The
+  // bracket [lo, hi] narrows with the sign of the residual, and a step that
+  // leaves it, including one with a vanishing slope, becomes a bisection.
+  double newtonStep(const double &sigma, const double &residual,
+                    const double &slope, double &lo, double &hi) {
+    if (residual > 0.0) {
+      hi = sigma;
+    } else {
+      lo = sigma;
+    }
+    const double next = sigma - residual / slope;
+    return next > lo && next < hi ? next : 0.5 * (lo + hi);
+  }
+
+  // the domain of BlackScholes::price, written so that NaNs fail; the
+  // option's volatility seeds the guess and must be usable too
+  bool isInvertible(const AmericanOption &option, const double &marketPrice) {
+    return option.getSpotPrice() > 0.0 && option.getStrikePrice() > 0.0 &&
+           option.getRiskFreeRate() >= 0.0 && option.getMaturity() > 0.0 &&
+           option.getVolatility() > 0.0 &&
+           std::isfinite(option.getSpotPrice()) &&
+           std::isfinite(option.getStrikePrice()) &&
+           std::isfinite(option.getRiskFreeRate()) &&
+           std::isfinite(option.getMaturity()) &&
+           std::isfinite(option.getVolatility()) &&
+           std::isfinite(option.getDividendYield()) && marketPrice > 0.0 &&
+           std::isfinite(marketPrice);
+  }
+
+} // namespace
+
+void ImpliedVolatility::impliedVolatilityBatch(
+    const std::vector<EuropeanOption> &options,
+    const std::vector<double> &marketPrices, double *vols,
+    const double &tolerance, const int &maxIterations) {
+  if (options.size() != marketPrices.size()) {
+    throw std::invalid_argument(ErrorMessages::ImpliedVol::kMismatchedQuotes);
+  }
+  const size_t n = options.size();
+  StripTerms terms;
+  for (std::vector<double> *column :
+       {&terms.sign, &terms.drift, &terms.sqrtT, &terms.spotDiscount,
+        &terms.strikeDiscount, &terms.target, &terms.inflection}) {
+    column->resize(n);
+  }
+  std::vector<double> sigma(n);
+  std::vector<size_t> active;
+  active.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    vols[i] = std::numeric_limits<double>::quiet_NaN();
+    const EuropeanOption &option = options[i];
+    const double S = option.getSpotPrice();
+    const double K = option.getStrikePrice();
+    const double r = option.getRiskFreeRate();
+    const double q = option.getDividendYield();
+    const double T = option.getMaturity();
+    if (!(S > 0.0 && K > 0.0 && r >= 0.0 && T > 0.0) || !std::isfinite(S) ||
+        !std::isfinite(K) || !std::isfinite(r) || !std::isfinite(q) ||
+        !std::isfinite(T)) {
+      continue;
+    }
+    const double w = option.getType() == OptionType::Call ? 1.0 : -1.0;
+    const double spotDiscount = S * std::exp(-q * T);
+    const double strikeDiscount = K * std::exp(-r * T);
+    const double lower = std::max(w * (spotDiscount - strikeDiscount), 0.0);
+    const double upper = w > 0.0 ? spotDiscount : strikeDiscount;
+    if (!(marketPrices[i] > lower && marketPrices[i] < upper)) {
+      continue;
+    }
+    terms.sign[i] = w;
+    terms.drift[i] = std::log(S / K) + (r - q) * T;
+    terms.sqrtT[i] = std::sqrt(T);
+    terms.spotDiscount[i] = spotDiscount;
+    terms.strikeDiscount[i] = strikeDiscount;
+    terms.target[i] = marketPrices[i];
+    terms.inflection[i] =
+        std::max(std::sqrt(2.0 * std::abs(terms.drift[i]) / T), kMinInflection);
+    const double guess = option.getVolatility();
+    sigma[i] =
+        guess > 0.0 && std::isfinite(guess) ? guess : terms.inflection[i];
+    active.push_back(i);
+  }
+
+  const std::vector<size_t> retry =
+      newtonSweeps(terms, std::move(active), sigma, tolerance, maxIterations,
+                   vols);
+  for (const size_t &i : retry) {
+    sigma[i] = terms.inflection[i];
+  }
+  // quotes failing from the inflection point too keep their NaN
+  newtonSweeps(terms, retry, sigma, tolerance, maxIterations, vols);
+}
+
+AmericanImpliedVolResult ImpliedVolatility::americanImpliedVolatility(
+    const AmericanOption &option, const double &marketPrice,
+    const AmericanImpliedVolConfig &config) {
+  validate(config);
+  const double S = option.getSpotPrice();
+  const double K = option.getStrikePrice();
+  const bool call = option.getType() == OptionType::Call;
+
+  AmericanImpliedVolResult result{std::numeric_limits<double>::quiet_NaN(),
+                                  ImpliedVolStatus::NotConverged, 0};
+  if (!isInvertible(option, marketPrice)) {
+    result.status = ImpliedVolStatus::InvalidInput;
+    return result;
+  }
+  if (marketPrice <= std::max(call ? S - K : K - S, 0.0)) {
+    result.status = ImpliedVolStatus::BelowIntrinsic;
+    return result;
+  }
+  if (marketPrice >= (call ? S : K)) {
+    result.status = ImpliedVolStatus::AboveUpperBound;
+    return result;
+  }
+
+  // Initial guess: Barone-Adesi-Whaley inverted from the option's own
+  // volatility, with the European vega as slope
+  AmericanOption trial = option;
+  double sigma = std::clamp<double>(option.getVolatility(),
+                                    config.minVolatility,
+                                    config.maxVolatility);
+  double lo = config.minVolatility;
+  double hi = config.maxVolatility;
+  for (int k = 0; k < config.guessIterations; ++k) {
+    trial.setVolatility(sigma);
+    const EuropeanOption european(S, K, option.getRiskFreeRate(),
+                                  option.getMaturity(), sigma,
+                                  option.getType(),
+                                  option.getDividendYield());
+    const double next = newtonStep(
+        sigma, AnalyticAmerican::baroneAdesiWhaley(trial) - marketPrice,
+        BlackScholes::vega(european), lo, hi);
+    const bool done = std::abs(next - sigma) < config.coarseTolerance;
+    sigma = next;
+    if (done) {
+      break;
+    }
+  }
+
+  // Reduced lattice while far from the root, the full one to finish
+  const bool coarse = config.coarseSteps < config.numSteps;
+  for (int stage = coarse ? 0 : 1; stage < 2; ++stage) {
+    const int &numSteps = stage == 0 ? config.coarseSteps : config.numSteps;
+    const double &tolerance =
+        stage == 0 ? config.coarseTolerance : config.tolerance;
+    lo = config.minVolatility;
+    hi = config.maxVolatility;
+    for (bool done = false; !done;) {
+      if (result.treeEvaluations == config.maxIterations) {
+        result.volatility = sigma;
+        return result;
+      }
+      trial.setVolatility(sigma);
+      const LatticeSensitivity tree =
+          BinomialTree::priceWithVega(trial, numSteps);
+      ++result.treeEvaluations;
+      const double next =
+          newtonStep(sigma, tree.price - marketPrice, tree.vega, lo, hi);
+      done = std::abs(next - sigma) < tolerance;
+      sigma = next;
+    }
+  }
+
+  result.volatility = sigma;
+  // a solution pinned to a bound means no volatility in range fits
+  if (sigma - config.minVolatility > config.tolerance &&
+      config.maxVolatility - sigma > config.tolerance) {
+    result.status = ImpliedVolStatus::Converged;
+  }
+  return result;
+}
+
+void ImpliedVolatility::americanImpliedVolatilityBatch(
+    const std::vector<AmericanOption> &options,
+    const std::vector<double> &marketPrices, AmericanImpliedVolResult *results,
+    const AmericanImpliedVolConfig &config, const unsigned &threads) {
+  if (options.size() != marketPrices.size()) {
+    throw std::invalid_argument(ErrorMessages::ImpliedVol::kMismatchedQuotes);
+  }
+  validate(config);
+  Parallel::forEach(
+      options.size(),
+      [&](const size_t i) {
+        results[i] =
+            americanImpliedVolatility(options[i], marketPrices[i], config);
+      },
+      threads);
+}
+
+void ImpliedVolatility::validate(const AmericanImpliedVolConfig &config) {
+  if (config.numSteps <= 0 || config.coarseSteps <= 0 ||
+      config.coarseTolerance <= 0.0 || config.tolerance <= 0.0 ||
+      config.guessIterations < 0 || config.maxIterations <= 0 ||
+      config.minVolatility <= 0.0 ||
+      config.maxVolatility <= config.minVolatility) {
+    throw std::invalid_argument(
+        ErrorMessages::ImpliedVol::kInvalidAmericanConfig);
+  }
 }
\ No newline at end of file
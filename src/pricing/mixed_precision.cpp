@@ -0,0 +1,72 @@
+#include "pricing/mixed_precision.h"
+#include "pricing/binomial_tree.h"
+#include "pricing/black_scholes.h"
+
+EuropeanOptionF MixedPrecision::toSingle(const EuropeanOption &option) {
+  return {static_cast<float>(option.getSpotPrice()),
+          static_cast<float>(option.getStrikePrice()),
+          static_cast<float>(option.getRiskFreeRate()),
+          static_cast<float>(option.getMaturity()),
+          static_cast<float>(option.getVolatility()),
+          option.getType(),
+          static_cast<float>(option.getDividendYield())};
+}
+
+AmericanOptionF MixedPrecision::toSingle(const AmericanOption &option) {
+  return {static_cast<float>(option.getSpotPrice()),
+          static_cast<float>(option.getStrikePrice()),
+          static_cast<float>(option.getRiskFreeRate()),
+          static_cast<float>(option.getMaturity()),
+          static_cast<float>(option.getVolatility()),
+          option.getType(),
+          static_cast<float>(option.getDividendYield())};
+}
+
+ScreeningResult MixedPrecision::screen(const std::vector<EuropeanOption> &book,
+                                       const Flag &flag) {
+  std::vector<EuropeanOptionF> singles;
+  singles.reserve(book.size());
+  for (const EuropeanOption &option : book) {
+    singles.push_back(toSingle(option));
+  }
+  std::vector<float> screened(book.size());
+  BlackScholes::priceBatch(singles, screened.data());
+
+  ScreeningResult result;
+  result.prices.assign(screened.begin(), screened.end());
+  for (size_t i = 0; i < book.size(); ++i) {
+    if (flag(i, screened[i])) {
+      result.flagged.push_back(i);
+      result.prices[i] = BlackScholes::price(book[i]);
+    }
+  }
+  return result;
+}
+
+ScreeningResult MixedPrecision::screen(const std::vector<AmericanOption> &book,
+                                       const int &numSteps, const Flag &flag) {
+  std::vector<AmericanOptionF> singles;
+  singles.reserve(book.size());
+  for (const AmericanOption &option : book) {
+    singles.push_back(toSingle(option));
+  }
+  std::vector<float> screened(book.size());
+  BinomialTree::priceBatch(singles, numSteps, screened.data());
+
+  ScreeningResult result;
+  result.prices.assign(screened.begin(), screened.end());
+  std::vector<AmericanOption> flagged;
+  for (size_t i = 0; i < book.size(); ++i) {
+    if (flag(i, screened[i])) {
+      result.flagged.push_back(i);
+      flagged.push_back(book[i]);
+    }
+  }
+  // the flagged contracts go through the double lane kernel together
+  std::vector<double> repriced(flagged.size());
+  BinomialTree::priceBatch(flagged, numSteps, repriced.data());
+  for (size_t k = 0; k < flagged.size(); ++k) {
+    result.prices[result.flagged[k]] = repriced[k];
+  }
+  return result;
+}
\ No newline at end of file
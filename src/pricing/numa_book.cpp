@@ -0,0 +1,56 @@
+#include "pricing/numa_book.h"
+
+template <typename OptionT>
+NumaBook<OptionT>::NumaBook(const std::vector<OptionT> &book,
+                            const NumaTopology &topology,
+                            const unsigned &threadsPerNode)
+    : topology_(topology), threadsPerNode_(threadsPerNode),
+      size_(book.size()) {
+  Numa::validate(topology_);
+  firstWorker_.push_back(0);
+  for (size_t n = 0; n < topology_.nodes.size(); ++n) {
+    firstWorker_.push_back(firstWorker_.back() + workers(n));
+  }
+  const size_t total = firstWorker_.back();
+  // only the slice headers live here; their contents are allocated below
+  slices_.resize(total);
+  Numa::forEachWorker(
+      topology_,
+      [&](const size_t node, const size_t worker, const size_t) {
+        const size_t g = firstWorker_[node] + worker;
+        const size_t begin = g * size_ / total;
+        const size_t end = (g + 1) * size_ / total;
+        Slice &slice = slices_[g];
+        slice.offset = begin;
+        slice.options.assign(book.begin() + static_cast<std::ptrdiff_t>(begin),
+                             book.begin() + static_cast<std::ptrdiff_t>(end));
+        slice.prices.assign(end - begin, 0.0);
+      },
+      threadsPerNode_);
+}
+
+template <typename OptionT>
+size_t NumaBook<OptionT>::workers(const size_t &node) const {
+  return threadsPerNode_ == 0 ? topology_.nodes[node].cpus.size()
+                              : threadsPerNode_;
+}
+
+template <typename OptionT> void NumaBook<OptionT>::run(const Kernel &kernel) {
+  Numa::forEachWorker(
+      topology_,
+      [&](const size_t node, const size_t worker, const size_t) {
+        Slice &slice = slices_[firstWorker_[node] + worker];
+        kernel(node, slice.options, slice.prices.data());
+      },
+      threadsPerNode_);
+}
+
+template <typename OptionT>
+void NumaBook<OptionT>::gather(double *prices) const {
+  for (const Slice &slice : slices_) {
+    std::copy(slice.prices.begin(), slice.prices.end(), prices + slice.offset);
+  }
+}
+
+template class NumaBook<EuropeanOption>;
+template class NumaBook<AmericanOption>;
\ No newline at end of file
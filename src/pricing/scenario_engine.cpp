@@ -0,0 +1,212 @@
+#include "pricing/scenario_engine.h"
+#include "error_messages.h"
+#include "pricing/binomial_tree.h"
+#include "pricing/black_scholes.h"
+#include "utils/numerical_methods.h"
+#include "utils/parallel.h"
+#include <cmath>
+#include <stdexcept>
+
+PnlCube::PnlCube(const size_t &contracts, const ShockGrid &grid)
+    : contracts_(contracts), spots_(grid.spotShocks.size()),
+      vols_(grid.volShocks.size()), rates_(grid.rateShocks.size()),
+      values_(contracts_ * spots_ * vols_ * rates_, 0.0) {}
+
+void ScenarioEngine::validate(const ShockGrid &grid) {
+  if (grid.spotShocks.empty() || grid.volShocks.empty() ||
+      grid.rateShocks.empty()) {
+    throw std::invalid_argument(ErrorMessages::Scenario::kEmptyShockGrid);
+  }
+  for (const double &shock : grid.spotShocks) {
+    if (shock <= -1.0) {
+      throw std::invalid_argument(ErrorMessages::Scenario::kInvalidSpotShock);
+    }
+  }
+}
+
+namespace {
+
+  // everything about a contract that no shock changes
+  struct ContractTerms {
+    double base;
+    double strike;
+    double rate;
+    double maturity;
+    double dividendYield;
+    double volatility;
+    double sign; // +1 call, -1 put
+    double logMoneyness;
+    double sqrtT;
+    double carrySpot; // S e^{-qT}
+  };
+
+  // a volatility after its shock, which must stay positive
+  double shockedVolatility(const double &sigma, const double &shock) {
+    const double shocked = sigma + shock;
+    if (shocked <= 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidVolatility);
+    }
+    return shocked;
+  }
+
+  // the contract checks BlackScholes::price makes, which the lattice skips
+  void validateContract(const AmericanOption &option) {
+    if (option.getSpotPrice() <= 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidSpotPrice);
+    }
+    if (option.getStrikePrice() <= 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidStrikePrice);
+    }
+    if (option.getRiskFreeRate() < 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidRiskFreeRate);
+    }
+    if (option.getMaturity() <= 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidTimeToMaturity);
+    }
+    if (option.getVolatility() <= 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidVolatility);
+    }
+  }
+
+} // namespace
+
+PnlCube ScenarioEngine::run(const std::vector<EuropeanOption> &book,
+                            const ShockGrid &grid, const unsigned &threads) {
+  validate(grid);
+  PnlCube cube(book.size(), grid);
+
+  // shared by every contract
+  const size_t spots = grid.spotShocks.size();
+  std::vector<double> spotFactor(spots);
+  std::vector<double> logSpotFactor(spots);
+  for (size_t s = 0; s < spots; ++s) {
+    spotFactor[s] = 1.0 + grid.spotShocks[s];
+    logSpotFactor[s] = std::log(spotFactor[s]);
+  }
+
+  // per contract, once for every (rate, vol, spot) scenario
+  const size_t tiles = (book.size() + kContractTile - 1) / kContractTile;
+  std::vector<ContractTerms> terms(book.size());
+  Parallel::forEach(
+      tiles,
+      [&](const size_t tile) {
+        const size_t end = std::min(book.size(), (tile + 1) * kContractTile);
+        for (size_t c = tile * kContractTile; c < end; ++c) {
+          const EuropeanOption &option = book[c];
+          const double S = option.getSpotPrice();
+          const double T = option.getMaturity();
+          const double q = option.getDividendYield();
+          terms[c] = {BlackScholes::price(option), // validates
+                      option.getStrikePrice(),
+                      option.getRiskFreeRate(),
+                      T,
+                      q,
+                      option.getVolatility(),
+                      option.getType() == OptionType::Call ? 1.0 : -1.0,
+                      std::log(S / option.getStrikePrice()),
+                      std::sqrt(T),
+                      S * std::exp(-q * T)};
+        }
+      },
+      threads);
+
+  const size_t rates = grid.rateShocks.size();
+  Parallel::forEach(
+      tiles * rates,
+      [&](const size_t item) {
+        const size_t tile = item / rates;
+        const size_t rate = item % rates;
+        const size_t end = std::min(book.size(), (tile + 1) * kContractTile);
+        for (size_t c = tile * kContractTile; c < end; ++c) {
+          const ContractTerms &contract = terms[c];
+          const double T = contract.maturity;
+          const double w = contract.sign;
+
+          const double r = contract.rate + grid.rateShocks[rate];
+          const double discountedStrike = contract.strike * std::exp(-r * T);
+          const double drift =
+              contract.logMoneyness + (r - contract.dividendYield) * T;
+
+          for (size_t v = 0; v < grid.volShocks.size(); ++v) {
+            const double shockedSigma =
+                shockedVolatility(contract.volatility, grid.volShocks[v]);
+            const double volSqrtT = shockedSigma * contract.sqrtT;
+            const double center = drift + 0.5 * shockedSigma * shockedSigma * T;
+
+            double *row = cube.spotRow(c, v, rate);
+            for (size_t s = 0; s < spots; ++s) {
+              const double d1 = (center + logSpotFactor[s]) / volSqrtT;
+              const double d2 = d1 - volSqrtT;
+              row[s] = w * (contract.carrySpot * spotFactor[s] *
+                                NumericalMethods::normalCdf(w * d1) -
+                            discountedStrike *
+                                NumericalMethods::normalCdf(w * d2)) -
+                       contract.base;
+            }
+          }
+        }
+      },
+      threads);
+
+  return cube;
+}
+
+PnlCube ScenarioEngine::run(const std::vector<AmericanOption> &book,
+                            const ShockGrid &grid, const int &numSteps,
+                            const unsigned &threads) {
+  validate(grid);
+  PnlCube cube(book.size(), grid);
+
+  for (const AmericanOption &option : book) {
+    validateContract(option);
+  }
+
+  // base prices once per contract
+  std::vector<double> base(book.size());
+  Parallel::forEach(
+      book.size(),
+      [&](const size_t c) { base[c] = BinomialTree::price(book[c], numSteps); },
+      threads);
+
+  // The vol x spot block of one (contract, rate) is contiguous in the cube,
+  // so its scenarios go through the lane-batched lattice in one call and
+  // land in place.
+  const size_t rates = grid.rateShocks.size();
+  const size_t scenarios = grid.volShocks.size() * grid.spotShocks.size();
+  Parallel::forEach(
+      book.size() * rates,
+      [&](const size_t item) {
+        const size_t c = item / rates;
+        const size_t rate = item % rates;
+        const AmericanOption &option = book[c];
+        const double r = option.getRiskFreeRate() + grid.rateShocks[rate];
+
+        std::vector<AmericanOption> shocked;
+        shocked.reserve(scenarios);
+        for (const double &volShock : grid.volShocks) {
+          const double sigma =
+              shockedVolatility(option.getVolatility(), volShock);
+          for (const double &spotShock : grid.spotShocks) {
+            shocked.emplace_back(option.getSpotPrice() * (1.0 + spotShock),
+                                 option.getStrikePrice(), r,
+                                 option.getMaturity(), sigma, option.getType(),
+                                 option.getDividendYield());
+          }
+        }
+
+        double *block = cube.spotRow(c, 0, rate);
+        BinomialTree::priceBatch(shocked, numSteps, block);
+        for (size_t k = 0; k < scenarios; ++k) {
+          block[k] -= base[c];
+        }
+      },
+      threads);
+
+  return cube;
+}
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "service/book_snapshot.h"
+#include "error_messages.h"
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+  constexpr std::uint32_t kFileMagic = 0x4B4E5053; // "SPNK"
+  // bump whenever SnapshotRecord or the header changes
+  constexpr std::uint32_t kFileVersion = 2;
+
+  struct SnapshotHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+    std::uint64_t count;
+    std::uint64_t inputs;
+    std::uint64_t checksum;
+  };
+
+  static_assert(sizeof(SnapshotHeader) % alignof(SnapshotRecord) == 0,
+                "records must stay aligned after the header");
+  static_assert(sizeof(SnapshotRecord) % sizeof(std::uint64_t) == 0,
+                "the checksum reads records as 64-bit words");
+
+  // FNV-1a over 64-bit words: one multiply per word, so validating a
+  // snapshot costs about as much as touching its pages
+  std::uint64_t checksum(const SnapshotRecord *records, const size_t &count) {
+    const auto *bytes = reinterpret_cast<const unsigned char *>(records);
+    const size_t words = count * sizeof(SnapshotRecord) / 8;
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < words; ++i) {
+      std::uint64_t word;
+      std::memcpy(&word, bytes + 8 * i, 8);
+      hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  template <typename OptionT>
+  SnapshotRecord makeRecord(const OptionT &option,
+                            const double &impliedVolatility) {
+    return {option.getSpotPrice(),
+            option.getStrikePrice(),
+            option.getRiskFreeRate(),
+            option.getMaturity(),
+            option.getVolatility(),
+            option.getDividendYield(),
+            impliedVolatility,
+            static_cast<std::int32_t>(option.getType()),
+            static_cast<std::int32_t>(OptionT::kExerciseStyle)};
+  }
+
+  // write(2) until every byte is out
+  bool writeAll(const int &fd, const void *data, size_t bytes) {
+    const auto *next = static_cast<const char *>(data);
+    while (bytes > 0) {
+      const ssize_t written = ::write(fd, next, bytes);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      next += written;
+      bytes -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+
+  // makes the rename itself durable: the directory entry lives in the
+  // parent directory's data, which fsync on the file does not flush
+  bool syncDirectory(const std::string &path) {
+    std::string directory = std::filesystem::path(path).parent_path();
+    if (directory.empty()) {
+      directory = ".";
+    }
+    const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+      return false;
+    }
+    const bool synced = ::fsync(fd) == 0;
+    return ::close(fd) == 0 && synced;
+  }
+
+  const SnapshotRecord &checkStyle(const SnapshotRecord &record,
+                                   const ExerciseStyle &style) {
+    if (record.exerciseStyle != static_cast<std::int32_t>(style)) {
+      throw std::invalid_argument(
+          ErrorMessages::Snapshot::kWrongExerciseStyle);
+    }
+    return record;
+  }
+
+  double warmStart(const SnapshotRecord &record) {
+    return std::isnan(record.impliedVolatility) ? record.volatility
+                                                : record.impliedVolatility;
+  }
+
+} // namespace
+
+SnapshotRecord BookSnapshot::record(const EuropeanOption &option,
+                                    const double &impliedVolatility) {
+  return makeRecord(option, impliedVolatility);
+}
+
+SnapshotRecord BookSnapshot::record(const AmericanOption &option,
+                                    const double &impliedVolatility) {
+  return makeRecord(option, impliedVolatility);
+}
+
+std::uint64_t BookSnapshot::fingerprint(const std::string_view &inputs,
+                                        const std::uint64_t &seed) {
+  std::uint64_t hash = seed;
+  for (const char &c : inputs) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+void BookSnapshot::save(const std::string &path,
+                        const std::vector<SnapshotRecord> &records,
+                        const std::uint64_t &inputs) {
+  const std::string temporary = path + ".tmp";
+  const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error(ErrorMessages::Snapshot::kUnwritableFile);
+  }
+  const SnapshotHeader header{kFileMagic,
+                              kFileVersion,
+                              sizeof(SnapshotRecord),
+                              0,
+                              records.size(),
+                              inputs,
+                              checksum(records.data(), records.size())};
+  // the data must be on disk before the rename publishes it, or a crash
+  // could leave the new name pointing at a torn file
+  const bool written =
+      writeAll(fd, &header, sizeof(header)) &&
+      writeAll(fd, records.data(), records.size() * sizeof(SnapshotRecord)) &&
+      ::fsync(fd) == 0;
+  if (::close(fd) != 0 || !written) {
+    std::remove(temporary.c_str());
+    throw std::runtime_error(ErrorMessages::Snapshot::kUnwritableFile);
+  }
+  if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    throw std::runtime_error(ErrorMessages::Snapshot::kUnwritableFile);
+  }
+  if (!syncDirectory(path)) {
+    throw std::runtime_error(ErrorMessages::Snapshot::kUnwritableFile);
+  }
+}
+
+BookSnapshot BookSnapshot::open(const std::string &path,
+                                const std::uint64_t &inputs) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(ErrorMessages::Snapshot::kUnreadableFile);
+  }
+  struct stat status {};
+  if (::fstat(fd, &status) != 0) {
+    ::close(fd);
+    throw std::runtime_error(ErrorMessages::Snapshot::kUnreadableFile);
+  }
+  const auto fileSize = static_cast<size_t>(status.st_size);
+  if (fileSize < sizeof(SnapshotHeader)) {
+    ::close(fd);
+    throw std::runtime_error(ErrorMessages::Snapshot::kCorruptFile);
+  }
+  void *mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error(ErrorMessages::Snapshot::kUnreadableFile);
+  }
+
+  // owns the mapping from here, so every rejection below unmaps it
+  BookSnapshot snapshot(mapping, fileSize);
+  SnapshotHeader header;
+  std::memcpy(&header, mapping, sizeof(header));
+  const size_t payload = fileSize - sizeof(SnapshotHeader);
+  if (header.magic != kFileMagic || header.version != kFileVersion ||
+      header.recordSize != sizeof(SnapshotRecord) ||
+      header.count != payload / sizeof(SnapshotRecord) ||
+      payload % sizeof(SnapshotRecord) != 0) {
+    throw std::runtime_error(ErrorMessages::Snapshot::kCorruptFile);
+  }
+  const auto *records = reinterpret_cast<const SnapshotRecord *>(
+      static_cast<const char *>(mapping) + sizeof(SnapshotHeader));
+  if (checksum(records, header.count) != header.checksum) {
+    throw std::runtime_error(ErrorMessages::Snapshot::kCorruptFile);
+  }
+  if (header.inputs != inputs) {
+    throw std::runtime_error(ErrorMessages::Snapshot::kStaleInputs);
+  }
+  snapshot.records_ = records;
+  snapshot.size_ = header.count;
+  return snapshot;
+}
+
+BookSnapshot::BookSnapshot(void *mapping, const size_t &mappedBytes)
+    : mapping_(mapping), mappedBytes_(mappedBytes), records_(nullptr),
+      size_(0) {}
+
+BookSnapshot::BookSnapshot(BookSnapshot &&other) noexcept
+    : mapping_(other.mapping_), mappedBytes_(other.mappedBytes_),
+      records_(other.records_), size_(other.size_) {
+  other.mapping_ = nullptr;
+  other.mappedBytes_ = 0;
+  other.records_ = nullptr;
+  other.size_ = 0;
+}
+
+BookSnapshot &BookSnapshot::operator=(BookSnapshot &&other) noexcept {
+  if (this != &other) {
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, mappedBytes_);
+    }
+    mapping_ = other.mapping_;
+    mappedBytes_ = other.mappedBytes_;
+    records_ = other.records_;
+    size_ = other.size_;
+    other.mapping_ = nullptr;
+    other.mappedBytes_ = 0;
+    other.records_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+BookSnapshot::~BookSnapshot() {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mappedBytes_);
+  }
+}
+
+EuropeanOption BookSnapshot::european(const size_t &i) const {
+  const SnapshotRecord &record =
+      checkStyle(records_[i], ExerciseStyle::European);
+  return {record.spotPrice,     record.strikePrice,
+          record.riskFreeRate,  record.maturity,
+          warmStart(record),    static_cast<OptionType>(record.type),
+          record.dividendYield};
+}
+
+AmericanOption BookSnapshot::american(const size_t &i) const {
+  const SnapshotRecord &record =
+      checkStyle(records_[i], ExerciseStyle::American);
+  return {record.spotPrice,     record.strikePrice,
+          record.riskFreeRate,  record.maturity,
+          warmStart(record),    static_cast<OptionType>(record.type),
+          record.dividendYield};
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "service/portfolio_risk.h"
+#include "error_messages.h"
+#include "utils/parallel.h"
+#include <cmath>
+
+namespace {
+
+  constexpr size_t kNoSlot = static_cast<size_t>(-1);
+
+  void accumulate(RiskMeasures &sum, const RiskMeasures &risk,
+                  const double &quantity) {
+    sum.price += quantity * risk.price;
+    sum.delta += quantity * risk.delta;
+    sum.gamma += quantity * risk.gamma;
+    sum.vega += quantity * risk.vega;
+    sum.theta += quantity * risk.theta;
+    sum.rho += quantity * risk.rho;
+  }
+
+  bool ascending(const std::vector<double> &edges) {
+    for (size_t i = 0; i < edges.size(); ++i) {
+      if (!std::isfinite(edges[i]) || (i > 0 && edges[i] <= edges[i - 1])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // edges at or below value; a branch-free count beats a binary search over
+  // the handful of edges a bucket grid has
+  size_t bucket(const std::vector<double> &edges, const double &value) {
+    size_t count = 0;
+    for (const double &edge : edges) {
+      count += edge <= value;
+    }
+    return count;
+  }
+
+  // running sum of one cell within a chunk
+  struct CellPartial {
+    size_t cell;
+    RiskMeasures risk;
+  };
+
+  // smallest power of two >= n
+  size_t powerOfTwoAtLeast(const size_t &n) {
+    size_t power = 1;
+    while (power < n) {
+      power <<= 1;
+    }
+    return power;
+  }
+
+} // namespace
+
+void PortfolioAggregator::validate(const GreekBuckets &buckets,
+                                   const PortfolioRiskConfig &config) {
+  if (!ascending(buckets.expiryEdges) || !ascending(buckets.moneynessEdges)) {
+    throw std::invalid_argument(ErrorMessages::Portfolio::kInvalidBuckets);
+  }
+  if (config.chunkSize == 0 || config.numSteps <= 0) {
+    throw std::invalid_argument(ErrorMessages::Portfolio::kInvalidConfig);
+  }
+}
+
+template <typename OptionT>
+PortfolioRisk PortfolioAggregator::aggregateImpl(
+    const std::vector<RiskPosition<OptionT>> &book,
+    const GreekBuckets &buckets, const PortfolioRiskConfig &config) {
+  validate(buckets, config);
+
+  PortfolioRisk result;
+  result.expiryBuckets = buckets.expiryEdges.size() + 1;
+  result.moneynessBuckets = buckets.moneynessEdges.size() + 1;
+  std::unordered_map<std::uint32_t, size_t> underlyingIndex;
+  for (const RiskPosition<OptionT> &position : book) {
+    if (underlyingIndex.try_emplace(position.underlying, 0).second) {
+      result.underlyings.push_back(position.underlying);
+    }
+  }
+  std::sort(result.underlyings.begin(), result.underlyings.end());
+  for (size_t u = 0; u < result.underlyings.size(); ++u) {
+    underlyingIndex[result.underlyings[u]] = u;
+  }
+  const size_t cellsPerUnderlying =
+      result.expiryBuckets * result.moneynessBuckets;
+  const size_t cells = result.underlyings.size() * cellsPerUnderlying;
+
+  const auto cellOf = [&](const RiskPosition<OptionT> &position) {
+    const OptionT &option = position.option;
+    return underlyingIndex.at(position.underlying) * cellsPerUnderlying +
+           bucket(buckets.expiryEdges, option.getMaturity()) *
+               result.moneynessBuckets +
+           bucket(buckets.moneynessEdges,
+                  option.getStrikePrice() / option.getSpotPrice());
+  };
+
+  // price each chunk in book order; chunk c leaves one partial per cell it
+  // touches
+  const size_t chunks = (book.size() + config.chunkSize - 1) / config.chunkSize;
+  std::vector<std::vector<CellPartial>> partials(chunks);
+  Parallel::forEach(
+      chunks,
+      [&](const size_t chunk) {
+        const size_t first = chunk * config.chunkSize;
+        const size_t last = std::min(first + config.chunkSize, book.size());
+        // cell -> index into out, open addressing in a table local to the
+        // chunk and sized by it, at most half full. Cells are small
+        // integers, so cell mod the power-of-two size is a fine hash.
+        const size_t mask =
+            powerOfTwoAtLeast(2 * std::min(last - first, cells)) - 1;
+        std::vector<size_t> slots(mask + 1, kNoSlot);
+        std::vector<CellPartial> &out = partials[chunk];
+        for (size_t k = first; k < last; ++k) {
+          const RiskPosition<OptionT> &position = book[k];
+          const size_t cell = cellOf(position);
+          size_t slot = cell & mask;
+          while (slots[slot] != kNoSlot && out[slots[slot]].cell != cell) {
+            slot = (slot + 1) & mask;
+          }
+          if (slots[slot] == kNoSlot) {
+            slots[slot] = out.size();
+            out.push_back({cell, RiskMeasures{}});
+          }
+          accumulate(out[slots[slot]].risk,
+                     RiskRunner::measure(position.option, config.numSteps),
+                     position.quantity);
+        }
+      },
+      config.threads);
+
+  // deterministic reduction: chunks in order, then cells in order
+  result.cells.assign(cells, RiskMeasures{});
+  for (const std::vector<CellPartial> &chunk : partials) {
+    for (const CellPartial &partial : chunk) {
+      result.cells[partial.cell] += partial.risk;
+    }
+  }
+  result.byUnderlying.assign(result.underlyings.size(), RiskMeasures{});
+  result.total = RiskMeasures{};
+  for (size_t u = 0; u < result.underlyings.size(); ++u) {
+    for (size_t c = 0; c < cellsPerUnderlying; ++c) {
+      result.byUnderlying[u] += result.cells[u * cellsPerUnderlying + c];
+    }
+    result.total += result.byUnderlying[u];
+  }
+  return result;
+}
+
+PortfolioRisk PortfolioAggregator::aggregate(
+    const std::vector<RiskPosition<EuropeanOption>> &book,
+    const GreekBuckets &buckets, const PortfolioRiskConfig &config) {
+  return aggregateImpl(book, buckets, config);
+}
+
+PortfolioRisk PortfolioAggregator::aggregate(
+    const std::vector<RiskPosition<AmericanOption>> &book,
+    const GreekBuckets &buckets, const PortfolioRiskConfig &config) {
+  return aggregateImpl(book, buckets, config);
+}
\ No newline at end of file
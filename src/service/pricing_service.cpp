@@ -0,0 +1,149 @@
+#include "service/pricing_service.h"
+#include "error_messages.h"
+#include "pricing/black_scholes.h"
+#include <stdexcept>
+
+namespace {
+
+  // mirrors the checks in BlackScholes::price
+  bool isPriceable(const EuropeanOption &option) {
+    return option.getSpotPrice() > 0.0 && option.getStrikePrice() > 0.0 &&
+           option.getRiskFreeRate() >= 0.0 && option.getMaturity() > 0.0 &&
+           option.getVolatility() > 0.0;
+  }
+
+} // namespace
+
+PricingService::PricingService(const PricingServiceConfig &config)
+    : config_(config), queue_(config.queueCapacity) {
+  if (config_.maxBatchSize == 0) {
+    throw std::invalid_argument(ErrorMessages::Service::kInvalidBatchSize);
+  }
+  options_.reserve(config_.maxBatchSize);
+  prices_.reserve(config_.maxBatchSize);
+  valid_.reserve(config_.maxBatchSize);
+  dispatcher_ = std::thread(&PricingService::dispatch, this);
+}
+
+PricingService::~PricingService() {
+  running_ = false;
+  {
+    const std::lock_guard<std::mutex> lock(wakeMutex_);
+    wake_.notify_one();
+  }
+  dispatcher_.join();
+}
+
+std::future<double> PricingService::submit(const EuropeanOption &option) {
+  RequestPtr request(new Request{option, {}, nullptr});
+  std::future<double> result = request->promise.get_future();
+  enqueue(request);
+  return result;
+}
+
+void PricingService::submit(const EuropeanOption &option, Callback callback) {
+  RequestPtr request(new Request{option, {}, std::move(callback)});
+  enqueue(request);
+}
+
+PricingServiceStats PricingService::stats() const {
+  return {requests_.load(), batches_.load()};
+}
+
+void PricingService::enqueue(RequestPtr &request) {
+  while (!queue_.tryPush(request)) {
+    std::this_thread::yield(); // backpressure
+  }
+  // pairs with the fence in dispatch(): either the dispatcher sees the new
+  // request before sleeping or we see it idle and wake it
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (idle_.load(std::memory_order_relaxed)) {
+    const std::lock_guard<std::mutex> lock(wakeMutex_);
+    wake_.notify_one();
+  }
+}
+
+void PricingService::dispatch() {
+  using Clock = std::chrono::steady_clock;
+  constexpr int kIdleSpins = 64;
+
+  std::vector<RequestPtr> batch;
+  batch.reserve(config_.maxBatchSize);
+  RequestPtr request;
+  int spins = 0;
+  for (;;) {
+    if (!queue_.tryPop(request)) {
+      if (!running_) {
+        break; // destructor called and the queue is drained
+      }
+      if (++spins < kIdleSpins) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(wakeMutex_);
+      idle_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      // the timeout only bounds the cost of a lost wake-up
+      wake_.wait_for(lock, std::chrono::milliseconds(1), [this] {
+        return queue_.sizeApprox() > 0 || !running_;
+      });
+      idle_.store(false, std::memory_order_relaxed);
+      continue;
+    }
+    spins = 0;
+
+    // coalesce until the batch is full or the latency budget is spent
+    batch.push_back(std::move(request));
+    const Clock::time_point deadline = Clock::now() + config_.maxBatchDelay;
+    while (batch.size() < config_.maxBatchSize) {
+      if (queue_.tryPop(request)) {
+        batch.push_back(std::move(request));
+      } else if (Clock::now() >= deadline) {
+        break;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+
+    process(batch);
+    batch.clear();
+  }
+}
+
+void PricingService::process(std::vector<RequestPtr> &batch) {
+  options_.clear();
+  valid_.clear();
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (isPriceable(batch[i]->option)) {
+      options_.push_back(batch[i]->option);
+      valid_.push_back(i);
+      continue;
+    }
+    // rerun the validating path to surface the usual error message
+    try {
+      complete(*batch[i], BlackScholes::price(batch[i]->option), nullptr);
+    } catch (...) {
+      complete(*batch[i], 0.0, std::current_exception());
+    }
+  }
+
+  prices_.resize(options_.size());
+  BlackScholes::priceBatch(options_, prices_.data());
+  for (size_t k = 0; k < valid_.size(); ++k) {
+    complete(*batch[valid_[k]], prices_[k], nullptr);
+  }
+
+  requests_.fetch_add(batch.size(), std::memory_order_relaxed);
+  batches_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PricingService::complete(Request &request, const double &price,
+                              const std::exception_ptr &error) {
+  if (request.callback) {
+    request.callback(price, error);
+  } else if (error) {
+    request.promise.set_exception(error);
+  } else {
+    request.promise.set_value(price);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,315 @@
+#include "service/quote_pipeline.h"
+#include "error_messages.h"
+#include "pricing/black_scholes.h"
+#include "pricing/implied_vol.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  // cold start of the Newton inversion when no surface is known yet
+  constexpr double kDefaultGuess = 0.2;
+} // namespace
+
+QuotePipeline::Context::Context(
+    const std::vector<RiskPosition<EuropeanOption>> &book,
+    const QuotePipelineConfig &config)
+    : book(book), config(config) {
+  validate(config);
+  for (size_t i = 0; i < book.size(); ++i) {
+    positions[book[i].underlying].push_back(i);
+  }
+}
+
+std::shared_ptr<const VolSurface>
+QuotePipeline::Context::latestSurface(const std::uint32_t &underlying) const {
+  const std::lock_guard<std::mutex> lock(surfacesMutex);
+  const auto it = surfaces.find(underlying);
+  return it == surfaces.end() ? nullptr : it->second.surface;
+}
+
+void QuotePipeline::Context::publish(
+    const std::uint32_t &underlying, const size_t &sequence,
+    const std::shared_ptr<const VolSurface> &surface) {
+  const std::lock_guard<std::mutex> lock(surfacesMutex);
+  const auto [it, inserted] =
+      surfaces.try_emplace(underlying, PublishedSurface{sequence, surface});
+  // a snapshot overtaken by a later one of the same underlying must not
+  // replace the later one's surface
+  if (!inserted && it->second.sequence < sequence) {
+    it->second = {sequence, surface};
+  }
+}
+
+void QuotePipeline::validate(const QuotePipelineConfig &config) {
+  if (config.queueCapacity == 0 ||
+      std::find(config.threads.begin(), config.threads.end(), 0u) !=
+          config.threads.end()) {
+    throw std::invalid_argument(ErrorMessages::Pipeline::kInvalidConfig);
+  }
+}
+
+size_t QuotePipeline::parse(Context &, Work &work) {
+  work.snapshot = DataParser::parseSnapshot(work.text);
+  work.result.underlying = work.snapshot.underlying;
+  std::string().swap(work.text);
+  return work.snapshot.quotes.size();
+}
+
+size_t QuotePipeline::invert(Context &context, Work &work) {
+  const QuoteSnapshot &snapshot = work.snapshot;
+  // each quote warm-started from the latest surface of the underlying
+  const std::shared_ptr<const VolSurface> surface =
+      context.latestSurface(snapshot.underlying);
+  std::vector<EuropeanOption> options;
+  std::vector<double> prices;
+  options.reserve(snapshot.quotes.size());
+  prices.reserve(snapshot.quotes.size());
+  for (const OptionQuote &quote : snapshot.quotes) {
+    const double guess = surface
+                             ? surface->volatility(quote.strike, quote.maturity)
+                             : kDefaultGuess;
+    options.emplace_back(snapshot.spot, quote.strike, snapshot.rate,
+                         quote.maturity, guess, quote.type,
+                         snapshot.dividendYield);
+    prices.push_back(quote.price);
+  }
+  work.vols.resize(snapshot.quotes.size());
+  ImpliedVolatility::impliedVolatilityBatch(
+      options, prices, work.vols.data(), context.config.ivTolerance,
+      context.config.ivMaxIterations);
+  size_t inverted = 0;
+  for (const double &vol : work.vols) {
+    inverted += !std::isnan(vol);
+  }
+  work.result.invertedQuotes = inverted;
+  work.result.rejectedQuotes = snapshot.quotes.size() - inverted;
+  return snapshot.quotes.size();
+}
+
+size_t QuotePipeline::fit(Context &context, Work &work) {
+  const QuoteSnapshot &snapshot = work.snapshot;
+  std::vector<double> strikes;
+  std::vector<double> maturities;
+  std::vector<double> vols;
+  strikes.reserve(work.result.invertedQuotes);
+  maturities.reserve(work.result.invertedQuotes);
+  vols.reserve(work.result.invertedQuotes);
+  for (size_t i = 0; i < snapshot.quotes.size(); ++i) {
+    if (!std::isnan(work.vols[i])) {
+      strikes.push_back(snapshot.quotes[i].strike);
+      maturities.push_back(snapshot.quotes[i].maturity);
+      vols.push_back(work.vols[i]);
+    }
+  }
+  if (vols.empty()) {
+    throw std::runtime_error(ErrorMessages::Pipeline::kNoImpliedVols);
+  }
+  work.result.surface = std::make_shared<const VolSurface>(
+      snapshot.spot, snapshot.rate, strikes, maturities, vols,
+      snapshot.dividendYield);
+  context.publish(snapshot.underlying, work.result.sequence,
+                  work.result.surface);
+  return vols.size();
+}
+
+size_t QuotePipeline::risk(Context &context, Work &work) {
+  QuotePipelineResult &result = work.result;
+  const auto it = context.positions.find(work.snapshot.underlying);
+  if (it != context.positions.end()) {
+    result.positions = it->second;
+  }
+
+  // the snapshot's carry, not the position's, so that a position on a quoted
+  // contract reprices to the quote
+  const QuoteSnapshot &snapshot = work.snapshot;
+  std::vector<EuropeanOption> options;
+  options.reserve(result.positions.size());
+  for (const size_t &index : result.positions) {
+    const EuropeanOption &held = context.book[index].option;
+    options.emplace_back(
+        snapshot.spot, held.getStrikePrice(), snapshot.rate, held.getMaturity(),
+        result.surface->volatility(held.getStrikePrice(), held.getMaturity()),
+        held.getType(), snapshot.dividendYield);
+  }
+  std::vector<Greeks> greeks(options.size());
+  BlackScholes::greeksBatch(options, greeks.data());
+
+  result.risk.resize(options.size());
+  result.total = RiskMeasures{};
+  for (size_t k = 0; k < options.size(); ++k) {
+    const double quantity = context.book[result.positions[k]].quantity;
+    const Greeks &g = greeks[k];
+    result.risk[k] = {quantity * g.price, quantity * g.delta,
+                      quantity * g.gamma, quantity * g.vega,
+                      quantity * g.theta, quantity * g.rho};
+    result.total += result.risk[k];
+  }
+  return options.size();
+}
+
+size_t QuotePipeline::process(const size_t &stage, Context &context,
+                              Work &work) {
+  switch (static_cast<PipelineStage>(stage)) {
+  case PipelineStage::Parse:
+    return parse(context, work);
+  case PipelineStage::Invert:
+    return invert(context, work);
+  case PipelineStage::Fit:
+    return fit(context, work);
+  default:
+    return risk(context, work);
+  }
+}
+
+QuotePipeline::QuotePipeline(
+    const std::vector<RiskPosition<EuropeanOption>> &book, Callback callback,
+    const QuotePipelineConfig &config)
+    : context_(book, config), callback_(std::move(callback)) {
+  for (size_t stage = 0; stage < kStages; ++stage) {
+    queues_[stage] = std::make_unique<BoundedQueue<Work>>(config.queueCapacity);
+    counters_[stage].running = config.threads[stage];
+  }
+  for (size_t stage = 0; stage < kStages; ++stage) {
+    for (unsigned t = 0; t < config.threads[stage]; ++t) {
+      threads_.emplace_back(&QuotePipeline::runStage, this, stage);
+    }
+  }
+}
+
+QuotePipeline::~QuotePipeline() {
+  counters_[0].closed = true;
+  for (std::thread &thread : threads_) {
+    thread.join();
+  }
+}
+
+size_t QuotePipeline::submit(std::string snapshot) {
+  Work work;
+  work.result.sequence = submitted_.fetch_add(1);
+  work.submitted = Clock::now();
+  work.text = std::move(snapshot);
+  push(0, work);
+  return work.result.sequence;
+}
+
+void QuotePipeline::drain() {
+  std::unique_lock<std::mutex> lock(drainMutex_);
+  drained_.wait(lock, [this] { return completed_ >= submitted_; });
+}
+
+QuotePipelineStats QuotePipeline::stats() const {
+  QuotePipelineStats stats{};
+  for (size_t stage = 0; stage < kStages; ++stage) {
+    const StageCounters &counters = counters_[stage];
+    stats.stages[stage] = {counters.snapshots.load(), counters.items.load(),
+                           std::chrono::nanoseconds(counters.busyNanos.load()),
+                           queues_[stage]->sizeApprox(),
+                           counters.peakQueueDepth.load()};
+  }
+  stats.completed = completed_.load();
+  return stats;
+}
+
+void QuotePipeline::push(const size_t &stage, Work &work) {
+  BoundedQueue<Work> &queue = *queues_[stage];
+  while (!queue.tryPush(work)) {
+    std::this_thread::yield(); // backpressure
+  }
+  const size_t depth = queue.sizeApprox();
+  std::atomic<size_t> &peak = counters_[stage].peakQueueDepth;
+  size_t seen = peak.load(std::memory_order_relaxed);
+  while (seen < depth && !peak.compare_exchange_weak(seen, depth)) {
+  }
+}
+
+void QuotePipeline::runStage(const size_t &stage) {
+  constexpr int kIdleSpins = 64;
+  constexpr std::chrono::microseconds kIdleSleep{50};
+
+  StageCounters &counters = counters_[stage];
+  BoundedQueue<Work> &queue = *queues_[stage];
+  Work work;
+  int spins = 0;
+  for (;;) {
+    if (!queue.tryPop(work)) {
+      if (counters.closed.load(std::memory_order_acquire)) {
+        // closed is set only once every upstream push has landed, so a queue
+        // still empty after it is empty for good
+        if (!queue.tryPop(work)) {
+          break;
+        }
+      } else {
+        if (++spins < kIdleSpins) {
+          std::this_thread::yield();
+        } else {
+          std::this_thread::sleep_for(kIdleSleep);
+        }
+        continue;
+      }
+    }
+    spins = 0;
+
+    const Clock::time_point start = Clock::now();
+    std::exception_ptr error;
+    try {
+      counters.items.fetch_add(process(stage, context_, work),
+                               std::memory_order_relaxed);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    counters.busyNanos.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             start)
+            .count(),
+        std::memory_order_relaxed);
+    counters.snapshots.fetch_add(1, std::memory_order_relaxed);
+
+    if (error || stage + 1 == kStages) {
+      complete(work, error);
+    } else {
+      push(stage + 1, work);
+    }
+    work = Work{};
+  }
+
+  if (--counters.running == 0 && stage + 1 < kStages) {
+    counters_[stage + 1].closed.store(true, std::memory_order_release);
+  }
+}
+
+void QuotePipeline::complete(Work &work, const std::exception_ptr &error) {
+  work.result.latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now() - work.submitted);
+  callback_(work.result, error);
+  {
+    const std::lock_guard<std::mutex> lock(drainMutex_);
+    ++completed_;
+  }
+  drained_.notify_all();
+}
+
+std::vector<QuotePipelineResult>
+QuotePipeline::runSerial(const std::vector<RiskPosition<EuropeanOption>> &book,
+                         const std::vector<std::string> &snapshots,
+                         const QuotePipelineConfig &config) {
+  Context context(book, config);
+  std::vector<QuotePipelineResult> results;
+  results.reserve(snapshots.size());
+  for (size_t i = 0; i < snapshots.size(); ++i) {
+    Work work;
+    work.result.sequence = i;
+    work.submitted = Clock::now();
+    work.text = snapshots[i];
+    for (size_t stage = 0; stage < kStages; ++stage) {
+      process(stage, context, work);
+    }
+    work.result.latency =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             work.submitted);
+    results.push_back(std::move(work.result));
+  }
+  return results;
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "service/risk_runner.h"
+#include "error_messages.h"
+#include "pricing/binomial_tree.h"
+#include "pricing/black_scholes.h"
+#include "utils/parallel.h"
+#include <csignal>
+#include <deque>
+#include <numeric>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+  constexpr double kRateBump = 1e-4;
+
+  // Anonymous shared mapping inherited by the forked workers: the risk of
+  // every position followed by one pricing-error flag per position
+  class SharedResults {
+  public:
+    explicit SharedResults(const size_t &count)
+        : count_(count),
+          bytes_(std::max<size_t>(count, 1) *
+                 (sizeof(RiskMeasures) + sizeof(std::uint8_t))),
+          data_(::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS, -1, 0)) {
+      if (data_ == MAP_FAILED) {
+        throw std::runtime_error(ErrorMessages::Risk::kSharedMemory);
+      }
+    }
+    ~SharedResults() { ::munmap(data_, bytes_); }
+    SharedResults(const SharedResults &) = delete;
+    SharedResults &operator=(const SharedResults &) = delete;
+
+    [[nodiscard]] RiskMeasures *data() const {
+      return static_cast<RiskMeasures *>(data_);
+    }
+    [[nodiscard]] std::uint8_t *failed() const {
+      return reinterpret_cast<std::uint8_t *>(data() + count_);
+    }
+
+  private:
+    size_t count_;
+    size_t bytes_;
+    void *data_;
+  };
+
+  struct RunningShard {
+    pid_t pid;
+    size_t shard;
+    int attempt;
+    std::chrono::steady_clock::time_point started;
+  };
+
+  // the contract checks BlackScholes::price makes; the lattice itself only
+  // checks numSteps and would price a negative volatility as its magnitude
+  void validateContract(const AmericanOption &option) {
+    if (option.getSpotPrice() <= 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidSpotPrice);
+    }
+    if (option.getStrikePrice() <= 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidStrikePrice);
+    }
+    if (option.getRiskFreeRate() < 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidRiskFreeRate);
+    }
+    if (option.getMaturity() <= 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidTimeToMaturity);
+    }
+    if (option.getVolatility() <= 0.0) {
+      throw std::invalid_argument(
+          ErrorMessages::BlackScholes::kInvalidVolatility);
+    }
+  }
+
+  void killAll(const std::vector<RunningShard> &running) {
+    for (const RunningShard &worker : running) {
+      ::kill(worker.pid, SIGKILL);
+      ::waitpid(worker.pid, nullptr, 0);
+    }
+  }
+
+} // namespace
+
+void RiskRunner::validate(const RiskRunnerConfig &config) {
+  if (config.workers == 0 || config.shardsPerWorker == 0 ||
+      config.shardTimeout.count() <= 0 || config.maxAttempts <= 0 ||
+      config.numSteps <= 0) {
+    throw std::invalid_argument(ErrorMessages::Risk::kInvalidConfig);
+  }
+}
+
+RiskMeasures RiskRunner::measure(const EuropeanOption &option, const int &) {
+  return {BlackScholes::price(option), BlackScholes::delta(option),
+          BlackScholes::gamma(option), BlackScholes::vega(option),
+          BlackScholes::theta(option), BlackScholes::rho(option)};
+}
+
+RiskMeasures RiskRunner::measure(const AmericanOption &option,
+                                 const int &numSteps) {
+  validateContract(option);
+  const LatticeSensitivity tree = BinomialTree::priceWithVega(option, numSteps);
+  const auto bumped = [&](const double &shift) {
+    const AmericanOption shifted(
+        option.getSpotPrice(), option.getStrikePrice(),
+        option.getRiskFreeRate() + shift, option.getMaturity(),
+        option.getVolatility(), option.getType(), option.getDividendYield());
+    return BinomialTree::price(shifted, numSteps);
+  };
+  return {tree.price,
+          BinomialTree::delta(option, numSteps),
+          BinomialTree::gamma(option, numSteps),
+          tree.vega,
+          BinomialTree::theta(option, numSteps),
+          (bumped(kRateBump) - bumped(-kRateBump)) / (2 * kRateBump)};
+}
+
+template <typename OptionT>
+RiskReport RiskRunner::runImpl(const std::vector<RiskPosition<OptionT>> &book,
+                               const RiskRunnerConfig &config) {
+  using Clock = std::chrono::steady_clock;
+  validate(config);
+
+  // book positions ordered by underlying; group g is
+  // order[groupStart[g], groupStart[g + 1])
+  std::vector<size_t> order(book.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](const size_t &a, const size_t &b) {
+                     return book[a].underlying < book[b].underlying;
+                   });
+  std::vector<size_t> groupStart;
+  for (size_t k = 0; k < order.size(); ++k) {
+    if (k == 0 ||
+        book[order[k]].underlying != book[order[k - 1]].underlying) {
+      groupStart.push_back(k);
+    }
+  }
+  const size_t groups = groupStart.size();
+  groupStart.push_back(order.size());
+
+  // shard s prices the groups [s * groups / shards, (s + 1) * groups / shards)
+  const size_t shards = std::min<size_t>(
+      groups, static_cast<size_t>(config.workers) * config.shardsPerWorker);
+  const auto shardBegin = [&](const size_t &shard) {
+    return groupStart[shard * groups / shards];
+  };
+
+  const SharedResults results(book.size());
+  RiskMeasures *shared = results.data();
+  std::uint8_t *failed = results.failed();
+  std::deque<std::pair<size_t, int>> pending; // (shard, attempt)
+  for (size_t shard = 0; shard < shards; ++shard) {
+    pending.emplace_back(shard, 0);
+  }
+  std::vector<RunningShard> running;
+  size_t reruns = 0;
+
+  const auto retry = [&](const RunningShard &worker) {
+    if (worker.attempt + 1 >= config.maxAttempts) {
+      killAll(running);
+      throw std::runtime_error(ErrorMessages::Risk::kShardFailed);
+    }
+    pending.emplace_back(worker.shard, worker.attempt + 1);
+    ++reruns;
+  };
+
+  while (!pending.empty() || !running.empty()) {
+    while (!pending.empty() && running.size() < config.workers) {
+      const auto [shard, attempt] = pending.front();
+      pending.pop_front();
+      const pid_t pid = ::fork();
+      if (pid < 0) {
+        killAll(running);
+        throw std::runtime_error(ErrorMessages::Risk::kForkFailed);
+      }
+      if (pid == 0) {
+        // worker: price the shard into the shared region and leave without
+        // running the parent's exit handlers. Only this thread exists in
+        // the child, hence the single-threaded caller requirement.
+        int status = 0;
+        try {
+          if (config.shardHook) {
+            config.shardHook(shard, attempt);
+          }
+          for (size_t k = shardBegin(shard); k < shardBegin(shard + 1); ++k) {
+            const RiskPosition<OptionT> &position = book[order[k]];
+            RiskMeasures risk;
+            // logic errors are the pricers' input checks: rerunning the
+            // shard would fail the same way, so report the position instead
+            try {
+              risk = measure(position.option, config.numSteps);
+              failed[order[k]] = 0;
+            } catch (const std::logic_error &) {
+              risk = RiskMeasures{};
+              failed[order[k]] = 1;
+            }
+            for (double *value : {&risk.price, &risk.delta, &risk.gamma,
+                                  &risk.vega, &risk.theta, &risk.rho}) {
+              *value *= position.quantity;
+            }
+            shared[order[k]] = risk;
+          }
+        } catch (...) {
+          status = 1; // anything else is treated like a crash
+        }
+        ::_exit(status);
+      }
+      running.push_back({pid, shard, attempt, Clock::now()});
+    }
+
+    // reap finished workers, kill overdue ones
+    for (size_t i = 0; i < running.size();) {
+      const RunningShard worker = running[i];
+      int status = 0;
+      const pid_t done = ::waitpid(worker.pid, &status, WNOHANG);
+      const bool overdue =
+          done == 0 && Clock::now() - worker.started > config.shardTimeout;
+      if (done == 0 && !overdue) {
+        ++i;
+        continue;
+      }
+      if (overdue) {
+        ::kill(worker.pid, SIGKILL);
+        ::waitpid(worker.pid, nullptr, 0);
+      }
+      running.erase(running.begin() + static_cast<std::ptrdiff_t>(i));
+      if (overdue || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        retry(worker);
+      }
+    }
+    if (!running.empty()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  RiskReport report;
+  report.positions.assign(shared, shared + book.size());
+  for (size_t i = 0; i < book.size(); ++i) {
+    if (failed[i] != 0) {
+      report.failed.push_back(i);
+    }
+  }
+  report.underlyings.resize(groups);
+  report.byUnderlying.assign(groups, RiskMeasures{});
+  Parallel::forEach(
+      groups,
+      [&](const size_t group) {
+        report.underlyings[group] = book[order[groupStart[group]]].underlying;
+        for (size_t k = groupStart[group]; k < groupStart[group + 1]; ++k) {
+          report.byUnderlying[group] += shared[order[k]];
+        }
+      },
+      config.workers);
+  report.total = RiskMeasures{};
+  for (const RiskMeasures &risk : report.byUnderlying) {
+    report.total += risk;
+  }
+  report.reruns = reruns;
+  return report;
+}
+
+RiskReport
+RiskRunner::run(const std::vector<RiskPosition<EuropeanOption>> &book,
+                const RiskRunnerConfig &config) {
+  return runImpl(book, config);
+}
+
+RiskReport
+RiskRunner::run(const std::vector<RiskPosition<AmericanOption>> &book,
+                const RiskRunnerConfig &config) {
+  return runImpl(book, config);
+}
\ No newline at end of file
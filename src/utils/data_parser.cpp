@@ -1 +1,105 @@
-// TODO: implement data parser
\ No newline at end of file
+#include "utils/data_parser.h"
+#include "error_messages.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace {
+
+  std::string_view trim(std::string_view text) {
+    const auto isSpace = [](const char c) {
+      return c == ' ' || c == '\t' || c == '\r';
+    };
+    while (!text.empty() && isSpace(text.front())) {
+      text.remove_prefix(1);
+    }
+    while (!text.empty() && isSpace(text.back())) {
+      text.remove_suffix(1);
+    }
+    return text;
+  }
+
+} // namespace
+
+bool DataParser::split(const std::string_view &line,
+                       std::vector<std::string_view> &fields) {
+  size_t start = 0;
+  for (size_t i = 0; i < fields.size(); ++i) {
+    const size_t end = line.find(',', start);
+    const bool last = i + 1 == fields.size();
+    if ((end == std::string_view::npos) != last) {
+      return false; // too few or too many fields
+    }
+    fields[i] = trim(line.substr(start, end - start));
+    start = end + 1;
+  }
+  return true;
+}
+
+bool DataParser::parseNumber(const std::string_view &field, double &value) {
+  const char *last = field.data() + field.size();
+  const auto [end, error] = std::from_chars(field.data(), last, value);
+  return error == std::errc() && end == last && std::isfinite(value);
+}
+
+OptionQuote DataParser::parseQuote(const std::string_view &line) {
+  std::vector<std::string_view> fields(4);
+  OptionQuote quote{};
+  if (!split(trim(line), fields) || fields[0].size() != 1 ||
+      !parseNumber(fields[1], quote.strike) ||
+      !parseNumber(fields[2], quote.maturity) ||
+      !parseNumber(fields[3], quote.price)) {
+    throw std::invalid_argument(ErrorMessages::Parser::kMalformedQuote);
+  }
+  switch (fields[0].front()) {
+  case 'C':
+    quote.type = OptionType::Call;
+    break;
+  case 'P':
+    quote.type = OptionType::Put;
+    break;
+  default:
+    throw std::invalid_argument(ErrorMessages::Parser::kMalformedQuote);
+  }
+  return quote;
+}
+
+QuoteSnapshot DataParser::parseSnapshot(const std::string_view &text) {
+  QuoteSnapshot snapshot{};
+  bool header = false;
+  size_t start = 0;
+  while (start <= text.size()) {
+    size_t end = text.find('\n', start);
+    if (end == std::string_view::npos) {
+      end = text.size();
+    }
+    const std::string_view line = trim(text.substr(start, end - start));
+    start = end + 1;
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+    if (header) {
+      snapshot.quotes.push_back(parseQuote(line));
+      continue;
+    }
+
+    // the dividend yield is optional
+    std::vector<std::string_view> fields(
+        std::count(line.begin(), line.end(), ',') == 3 ? 4 : 3);
+    double underlying = 0.0;
+    if (!split(line, fields) || !parseNumber(fields[0], underlying) ||
+        underlying < 0.0 || underlying != std::floor(underlying) ||
+        underlying > UINT32_MAX || !parseNumber(fields[1], snapshot.spot) ||
+        !parseNumber(fields[2], snapshot.rate) ||
+        (fields.size() == 4 &&
+         !parseNumber(fields[3], snapshot.dividendYield))) {
+      throw std::invalid_argument(ErrorMessages::Parser::kMalformedHeader);
+    }
+    snapshot.underlying = static_cast<std::uint32_t>(underlying);
+    header = true;
+  }
+  if (!header) {
+    throw std::invalid_argument(ErrorMessages::Parser::kMalformedHeader);
+  }
+  return snapshot;
+}
\ No newline at end of file
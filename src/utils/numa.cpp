@@ -0,0 +1,125 @@
+#include "utils/numa.h"
+#include "error_messages.h"
+#include "utils/parallel.h"
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sched.h>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+  bool readLine(const std::string &path, std::string &line) {
+    std::ifstream in(path);
+    return static_cast<bool>(std::getline(in, line));
+  }
+
+} // namespace
+
+std::vector<int> Numa::parseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::stringstream ranges(list);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    const size_t dash = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last =
+          dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      if (first < 0 || last < first) {
+        throw std::invalid_argument(range);
+      }
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::logic_error &) {
+      throw std::invalid_argument(ErrorMessages::Numa::kInvalidCpuList);
+    }
+  }
+  return cpus;
+}
+
+NumaTopology Numa::discover(const std::string &root) {
+  NumaTopology topology;
+  std::string online;
+  if (readLine(root + "/online", online)) {
+    for (const int id : parseCpuList(online)) {
+      std::string cpulist;
+      if (!readLine(root + "/node" + std::to_string(id) + "/cpulist",
+                    cpulist)) {
+        continue;
+      }
+      std::vector<int> cpus = parseCpuList(cpulist);
+      if (!cpus.empty()) {
+        topology.nodes.push_back({id, std::move(cpus)});
+      }
+    }
+  }
+  if (topology.nodes.empty()) {
+    NumaNode node{0, {}};
+    for (unsigned cpu = 0; cpu < Parallel::defaultThreadCount(); ++cpu) {
+      node.cpus.push_back(static_cast<int>(cpu));
+    }
+    topology.nodes.push_back(std::move(node));
+  }
+  return topology;
+}
+
+bool Numa::pinCurrentThread(const int &cpu) {
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+void Numa::validate(const NumaTopology &topology) {
+  if (topology.nodes.empty()) {
+    throw std::invalid_argument(ErrorMessages::Numa::kEmptyTopology);
+  }
+  for (const NumaNode &node : topology.nodes) {
+    if (node.cpus.empty()) {
+      throw std::invalid_argument(ErrorMessages::Numa::kEmptyTopology);
+    }
+  }
+}
+
+void Numa::forEachWorker(
+    const NumaTopology &topology,
+    const std::function<void(size_t node, size_t worker, size_t workers)>
+        &body,
+    const unsigned &threadsPerNode) {
+  validate(topology);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  std::vector<std::thread> pool;
+  for (size_t n = 0; n < topology.nodes.size(); ++n) {
+    const std::vector<int> &cpus = topology.nodes[n].cpus;
+    const size_t workers = threadsPerNode == 0 ? cpus.size() : threadsPerNode;
+    for (size_t w = 0; w < workers; ++w) {
+      pool.emplace_back([&, n, w, workers] {
+        pinCurrentThread(cpus[w % cpus.size()]);
+        try {
+          body(n, w, workers);
+        } catch (...) {
+          const std::lock_guard<std::mutex> lock(errorMutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      });
+    }
+  }
+  for (std::thread &thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
\ No newline at end of file
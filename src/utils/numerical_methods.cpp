@@ -1,4 +1,5 @@
 #include "utils/numerical_methods.h"
+#include "error_messages.h"
 #include <cmath>
 #include <stdexcept>
 
@@ -14,7 +15,6 @@ double NumericalMethods::newtonRaphson(
     }
 
     double fprimex = fprime(x);
-    std::cout << "fprimex: " << fprimex << ", x: " << x << std::endl;
     if (std::abs(fprimex) < 1e-15) {
       throw std::runtime_error("Newton-Raphson: Derivative is close to zero.");
     }
@@ -24,4 +24,167 @@ double NumericalMethods::newtonRaphson(
 
   throw std::runtime_error(
       "Newton-Raphson: Maximum iterations reached without convergence.");
+}
+
+namespace {
+
+  constexpr double kPi = 3.14159265358979323846;
+
+  // full-precision cdf for the bivariate integrand
+  double normalCdfErfc(const double &x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+  }
+
+  // P(X > h, Y > k); transcription of Genz's BVND
+  double upperBivariateNormal(const double &h0, const double &k0,
+                              const double &r) {
+    static const QuadratureRule rule6 = NumericalMethods::gaussLegendre(6);
+    static const QuadratureRule rule12 = NumericalMethods::gaussLegendre(12);
+    static const QuadratureRule rule20 = NumericalMethods::gaussLegendre(20);
+    const QuadratureRule &rule = std::abs(r) < 0.3    ? rule6
+                                 : std::abs(r) < 0.75 ? rule12
+                                                      : rule20;
+
+    double h = h0;
+    double k = k0;
+    double hk = h * k;
+    double bvn = 0.0;
+
+    if (std::abs(r) < 0.925) {
+      if (r != 0.0) {
+        const double hs = (h * h + k * k) / 2.0;
+        const double asr = std::asin(r);
+        for (size_t i = 0; i < rule.nodes.size(); ++i) {
+          const double sn = std::sin(asr * (rule.nodes[i] + 1.0) / 2.0);
+          bvn += rule.weights[i] * std::exp((sn * hk - hs) / (1.0 - sn * sn));
+        }
+        bvn *= asr / (4.0 * kPi);
+      }
+      return bvn + normalCdfErfc(-h) * normalCdfErfc(-k);
+    }
+
+    if (r < 0.0) {
+      k = -k;
+      hk = -hk;
+    }
+    if (std::abs(r) < 1.0) {
+      const double as = (1.0 - r) * (1.0 + r);
+      double a = std::sqrt(as);
+      const double bs = (h - k) * (h - k);
+      const double c = (4.0 - hk) / 8.0;
+      const double d = (12.0 - hk) / 16.0;
+      double asr = -(bs / as + hk) / 2.0;
+      if (asr > -100.0) {
+        bvn = a * std::exp(asr) *
+              (1.0 - c * (bs - as) * (1.0 - d * bs / 5.0) / 3.0 +
+               c * d * as * as / 5.0);
+      }
+      if (-hk < 100.0) {
+        const double b = std::sqrt(bs);
+        bvn -= std::exp(-hk / 2.0) * std::sqrt(2.0 * kPi) *
+               normalCdfErfc(-b / a) * b *
+               (1.0 - c * bs * (1.0 - d * bs / 5.0) / 3.0);
+      }
+      a /= 2.0;
+      for (size_t i = 0; i < rule.nodes.size(); ++i) {
+        const double xs = std::pow(a * (rule.nodes[i] + 1.0), 2);
+        const double rs = std::sqrt(1.0 - xs);
+        asr = -(bs / xs + hk) / 2.0;
+        if (asr > -100.0) {
+          bvn += a * rule.weights[i] * std::exp(asr) *
+                 (std::exp(-hk * (1.0 - rs) / (2.0 * (1.0 + rs))) / rs -
+                  (1.0 + c * xs * (1.0 + d * xs)));
+        }
+      }
+      bvn = -bvn / (2.0 * kPi);
+    }
+
+    if (r > 0.0) {
+      return bvn + normalCdfErfc(-std::max(h, k));
+    }
+    bvn = -bvn;
+    if (k > h) {
+      bvn += normalCdfErfc(k) - normalCdfErfc(h);
+    }
+    return bvn;
+  }
+
+} // namespace
+
+double NumericalMethods::bivariateNormalCdf(const double &x, const double &y,
+                                            const double &rho) {
+  return upperBivariateNormal(-x, -y, rho);
+}
+
+QuadratureRule NumericalMethods::gaussLegendre(const int &n) {
+  QuadratureRule rule;
+  rule.nodes.resize(n);
+  rule.weights.resize(n);
+  for (int i = 0; i < (n + 1) / 2; ++i) {
+    // roots are symmetric, so only the positive half is iterated
+    double x = std::cos(kPi * (i + 0.75) / (n + 0.5));
+    double derivative = 0.0;
+    for (int iteration = 0; iteration < 100; ++iteration) {
+      double p0 = 1.0;
+      double p1 = x;
+      for (int j = 2; j <= n; ++j) {
+        const double p2 = ((2.0 * j - 1.0) * x * p1 - (j - 1.0) * p0) / j;
+        p0 = p1;
+        p1 = p2;
+      }
+      derivative = n * (x * p1 - p0) / (x * x - 1.0);
+      const double dx = p1 / derivative;
+      x -= dx;
+      if (std::abs(dx) < 1e-16) {
+        break;
+      }
+    }
+    const double weight = 2.0 / ((1.0 - x * x) * derivative * derivative);
+    rule.nodes[i] = -x;
+    rule.nodes[n - 1 - i] = x;
+    rule.weights[i] = weight;
+    rule.weights[n - 1 - i] = weight;
+  }
+  return rule;
+}
+
+void NumericalMethods::fft(std::vector<std::complex<double>> &data) {
+  const size_t n = data.size();
+  if (n == 0 || (n & (n - 1)) != 0) {
+    throw std::invalid_argument(
+        ErrorMessages::NumericalMethods::kInvalidFftSize);
+  }
+  for (size_t i = 1, j = 0; i < n; ++i) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(data[i], data[j]);
+    }
+  }
+  for (size_t length = 2; length <= n; length <<= 1) {
+    const double angle = -2.0 * kPi / static_cast<double>(length);
+    const size_t half = length / 2;
+    // twiddles computed directly rather than by repeated rotation, which
+    // would drift by O(length * eps)
+    std::vector<std::complex<double>> twiddles(half);
+    for (size_t k = 0; k < half; ++k) {
+      twiddles[k] = std::polar(1.0, angle * static_cast<double>(k));
+    }
+    for (size_t start = 0; start < n; start += length) {
+      for (size_t k = 0; k < half; ++k) {
+        // written out: operator* takes the slow C99 Annex G path for
+        // inf/nan operands
+        const std::complex<double> &w = twiddles[k];
+        const std::complex<double> &x = data[start + k + half];
+        const std::complex<double> odd(
+            w.real() * x.real() - w.imag() * x.imag(),
+            w.real() * x.imag() + w.imag() * x.real());
+        data[start + k + half] = data[start + k] - odd;
+        data[start + k] += odd;
+      }
+    }
+  }
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "utils/parallel.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+unsigned Parallel::defaultThreadCount() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void Parallel::forEach(const size_t &count,
+                       const std::function<void(size_t)> &body,
+                       const unsigned &threads) {
+  const size_t workers = std::min<size_t>(
+      threads == 0 ? defaultThreadCount() : threads, count);
+  if (workers <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      body(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto work = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      try {
+        body(i);
+      } catch (...) {
+        const std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        next = count; // stop handing out items
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(workers - 1);
+  for (size_t t = 1; t < workers; ++t) {
+    pool.emplace_back(work);
+  }
+  work();
+  for (std::thread &thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+Barrier::Barrier(const size_t &count) : count_(std::max<size_t>(count, 1)) {}
+
+void Barrier::arriveAndWait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const size_t phase = phase_;
+  if (++waiting_ == count_) {
+    waiting_ = 0;
+    ++phase_;
+    released_.notify_all();
+    return;
+  }
+  released_.wait(lock, [&] { return phase_ != phase; });
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "error_messages.h"
+#include "market/dividend_schedule.h"
+#include "market/vol_surface.h"
+#include "market/yield_curve.h"
+#include <cmath>
+#include <gtest/gtest.h>
+
+TEST(YieldCurveTest, FlatCurve) {
+  const YieldCurve curve = YieldCurve::flat(0.05);
+  ASSERT_DOUBLE_EQ(curve.discount(0.0), 1.0);
+  ASSERT_NEAR(curve.discount(2.0), std::exp(-0.1), 1e-15);
+  ASSERT_NEAR(curve.zeroRate(3.0), 0.05, 1e-12);
+  ASSERT_NEAR(curve.forwardRate(0.5, 1.5), 0.05, 1e-12);
+}
+
+TEST(YieldCurveTest, PiecewiseFlatForwards) {
+  const YieldCurve curve({1.0, 2.0}, {0.02, 0.03});
+  // forward between the pillars is (0.03 * 2 - 0.02 * 1) / (2 - 1)
+  ASSERT_NEAR(curve.forwardRate(1.2, 1.8), 0.04, 1e-12);
+  ASSERT_NEAR(curve.zeroRate(1.0), 0.02, 1e-12);
+  ASSERT_NEAR(curve.zeroRate(2.0), 0.03, 1e-12);
+  // extrapolated with the last forward
+  ASSERT_NEAR(curve.forwardRate(2.5, 3.0), 0.04, 1e-12);
+}
+
+TEST(YieldCurveTest, DiscountTableMatchesDiscount) {
+  const YieldCurve curve({0.25, 1.0, 2.0}, {0.01, 0.02, 0.025});
+  constexpr int numSteps = 37;
+  const std::vector<double> table = curve.discountTable(3.0, numSteps);
+  ASSERT_EQ(table.size(), numSteps + 1);
+  for (int i = 0; i <= numSteps; ++i) {
+    ASSERT_NEAR(table[i], curve.discount(i * 3.0 / numSteps), 1e-15);
+  }
+}
+
+TEST(YieldCurveTest, InvalidPillars) {
+  ASSERT_THROW(YieldCurve({1.0, 0.5}, {0.01, 0.02}), std::invalid_argument);
+  ASSERT_THROW(YieldCurve({1.0}, {0.01, 0.02}), std::invalid_argument);
+  ASSERT_THROW(YieldCurve({}, {}), std::invalid_argument);
+}
+
+TEST(DividendScheduleTest, PresentValue) {
+  const YieldCurve curve = YieldCurve::flat(0.05);
+  const DividendSchedule dividends({{0.75, 1.0}, {0.25, 2.0}});
+  ASSERT_EQ(dividends.getDividends().front().time, 0.25);
+  ASSERT_NEAR(dividends.presentValue(curve, 0.0, 1.0),
+              2.0 * std::exp(-0.05 * 0.25) + std::exp(-0.05 * 0.75), 1e-15);
+  ASSERT_NEAR(dividends.presentValue(curve, 0.25, 1.0),
+              std::exp(-0.05 * 0.75), 1e-15);
+  ASSERT_THROW(DividendSchedule({{-1.0, 1.0}}), std::invalid_argument);
+}
+
+TEST(DividendScheduleTest, RemainingValueTable) {
+  const YieldCurve curve({0.5, 1.0}, {0.03, 0.04});
+  const DividendSchedule dividends({{0.3, 1.5}, {0.8, 1.0}, {2.0, 5.0}});
+  constexpr int numSteps = 10;
+  const std::vector<double> table =
+      dividends.remainingValueTable(curve, 1.0, numSteps);
+  for (int i = 0; i <= numSteps; ++i) {
+    const double t = i * 0.1;
+    ASSERT_NEAR(table[i],
+                dividends.presentValue(curve, t, 1.0) / curve.discount(t),
+                1e-12);
+  }
+  ASSERT_EQ(table[numSteps], 0.0);
+}
+
+TEST(VolSurfaceTest, RecoversQuadraticSmiles) {
+  const double spot = 100.0;
+  const double rate = 0.02;
+  const auto smile = [&](const double &strike, const double &maturity) {
+    const double k = std::log(strike / (spot * std::exp(rate * maturity)));
+    return 0.2 / std::sqrt(maturity) - 0.1 * k + 0.3 * k * k;
+  };
+  std::vector<double> strikes;
+  std::vector<double> maturities;
+  std::vector<double> vols;
+  for (const double maturity : {1.0, 0.25}) {
+    for (double strike = 80.0; strike <= 120.0; strike += 5.0) {
+      strikes.push_back(strike);
+      maturities.push_back(maturity);
+      vols.push_back(smile(strike, maturity));
+    }
+  }
+  const VolSurface surface(spot, rate, strikes, maturities, vols);
+  ASSERT_EQ(surface.expiries(), (std::vector<double>{0.25, 1.0}));
+  ASSERT_NEAR(surface.volatility(92.5, 0.25), smile(92.5, 0.25), 1e-10);
+  ASSERT_NEAR(surface.volatility(107.0, 1.0), smile(107.0, 1.0), 1e-10);
+  // flat beyond the quoted strikes and expiries
+  ASSERT_NEAR(surface.volatility(60.0, 1.0), smile(80.0, 1.0), 1e-10);
+  ASSERT_NEAR(surface.volatility(100.0, 3.0), smile(100.0, 1.0), 1e-10);
+  ASSERT_NEAR(surface.volatility(100.0, 0.1), smile(100.0, 0.25), 1e-10);
+
+  // linear in total variance between the expiries
+  const double v0 = smile(100.0, 0.25);
+  const double v1 = smile(100.0, 1.0);
+  const double w = 0.5 * (v0 * v0 * 0.25 + v1 * v1 * 1.0);
+  ASSERT_NEAR(surface.volatility(100.0, 0.625), std::sqrt(w / 0.625), 1e-10);
+}
+
+TEST(VolSurfaceTest, FewStrikesAndInvalidData) {
+  // one and two strikes fit flat and linear smiles
+  const VolSurface flat(100.0, 0.0, {100.0}, {0.5}, {0.3});
+  ASSERT_NEAR(flat.volatility(80.0, 0.5), 0.3, 1e-15);
+  const VolSurface linear(100.0, 0.0, {90.0, 110.0}, {1.0, 1.0}, {0.3, 0.2});
+  ASSERT_NEAR(linear.volatility(90.0, 1.0), 0.3, 1e-12);
+  ASSERT_NEAR(linear.volatility(110.0, 1.0), 0.2, 1e-12);
+
+  ASSERT_THROW(VolSurface(100.0, 0.0, {}, {}, {}), std::invalid_argument);
+  ASSERT_THROW(VolSurface(100.0, 0.0, {100.0}, {0.5, 1.0}, {0.2}),
+               std::invalid_argument);
+  ASSERT_THROW(VolSurface(100.0, 0.0, {100.0}, {0.5}, {-0.2}),
+               std::invalid_argument);
+}
\ No newline at end of file
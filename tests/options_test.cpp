@@ -1,4 +1,5 @@
 #include "options/american_option.h"
+#include "options/bermudan_option.h"
 #include "options/european_option.h"
 #include <gtest/gtest.h>
 
@@ -62,4 +63,12 @@ TEST(EuropeanOptionTest, IsAmerican) {
 TEST(AmericanOptionTest, IsAmerican) {
   AmericanOption option(100.0, 95.0, 0.05, 1.0, 0.2, OptionType::Put);
   ASSERT_TRUE(option.isAmerican());
+}
+
+TEST(BermudanOptionTest, ExerciseSchedule) {
+  BermudanOption option(100.0, 95.0, 0.05, 1.0, 0.2, OptionType::Put,
+                        {0.75, 0.25, 0.5});
+  ASSERT_FALSE(option.isAmerican());
+  ASSERT_EQ(option.getExerciseTimes(), (std::vector<double>{0.25, 0.5, 0.75}));
+  ASSERT_EQ(BermudanOption::kExerciseStyle, ExerciseStyle::Bermudan);
 }
\ No newline at end of file
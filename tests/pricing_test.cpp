@@ -1,10 +1,18 @@
 #include "options/american_option.h"
 #include "options/european_option.h"
+#include "pricing/analytic_american.h"
 #include "pricing/binomial_tree.h"
 #include "pricing/black_scholes.h"
+#include "pricing/chebyshev_proxy.h"
+#include "pricing/heston.h"
 #include "pricing/implied_vol.h"
+#include "pricing/mixed_precision.h"
+#include "pricing/numa_book.h"
+#include "pricing/scenario_engine.h"
 #include "utils/numerical_methods.h"
 #include <cmath>
+#include <fstream>
+#include <limits>
 #include <gtest/gtest.h>
 
 TEST(BlackScholesTest, CallOptionPrice) {
@@ -79,6 +87,27 @@ TEST(BlackScholesTest, PutOptionRho) {
   ASSERT_NEAR(rho, -41.8905, 1e-4);
 }
 
+TEST(BlackScholesTest, GreeksBatchMatchesScalar) {
+  std::vector<EuropeanOption> book;
+  for (int i = 0; i < 24; ++i) {
+    book.emplace_back(100.0, 70.0 + 2.5 * i, 0.01 * (i % 5), 0.1 + 0.2 * i,
+                      0.15 + 0.01 * i,
+                      i % 2 ? OptionType::Put : OptionType::Call,
+                      0.005 * (i % 3));
+  }
+  std::vector<Greeks> greeks(book.size());
+  BlackScholes::greeksBatch(book, greeks.data());
+  for (size_t i = 0; i < book.size(); ++i) {
+    const EuropeanOption &option = book[i];
+    ASSERT_NEAR(greeks[i].price, BlackScholes::price(option), 1e-12);
+    ASSERT_NEAR(greeks[i].delta, BlackScholes::delta(option), 1e-14);
+    ASSERT_NEAR(greeks[i].gamma, BlackScholes::gamma(option), 1e-14);
+    ASSERT_NEAR(greeks[i].vega, BlackScholes::vega(option), 1e-12);
+    ASSERT_NEAR(greeks[i].theta, BlackScholes::theta(option), 1e-12);
+    ASSERT_NEAR(greeks[i].rho, BlackScholes::rho(option), 1e-12);
+  }
+}
+
 TEST(BinomialTreeTest, AmericanCallOptionPrice) {
   AmericanOption option(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call);
   int numSteps = 1000;
@@ -93,10 +122,720 @@ TEST(BinomialTreeTest, AmericanPutOptionPrice) {
   ASSERT_NEAR(price, 6.0896, 1e-2);
 }
 
+TEST(BinomialTreeTest, EuropeanConvergesToBlackScholes) {
+  const EuropeanOption call(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call);
+  const EuropeanOption put(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  constexpr int numSteps = 2000;
+  ASSERT_NEAR(BinomialTree::price(call, numSteps), BlackScholes::price(call),
+              1e-2);
+  ASSERT_NEAR(BinomialTree::price(put, numSteps), BlackScholes::price(put),
+              1e-2);
+}
+
+TEST(BinomialTreeTest, BermudanPutBetweenEuropeanAndAmerican) {
+  constexpr int numSteps = 500;
+  const EuropeanOption european(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  const AmericanOption american(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  const BermudanOption bermudan(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put,
+                                {0.25, 0.5, 0.75});
+  const double europeanPrice = BinomialTree::price(european, numSteps);
+  const double americanPrice = BinomialTree::price(american, numSteps);
+  const double bermudanPrice = BinomialTree::price(bermudan, numSteps);
+  ASSERT_GT(bermudanPrice, europeanPrice);
+  ASSERT_LT(bermudanPrice, americanPrice);
+}
+
+TEST(BinomialTreeTest, BermudanScheduleLimits) {
+  constexpr int numSteps = 100;
+  std::vector<double> everyStep;
+  for (int i = 0; i <= numSteps; ++i) {
+    everyStep.push_back(static_cast<double>(i) / numSteps);
+  }
+  const BermudanOption dense(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put,
+                             everyStep);
+  const BermudanOption empty(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put,
+                             {});
+  const AmericanOption american(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  const EuropeanOption european(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  ASSERT_DOUBLE_EQ(BinomialTree::price(dense, numSteps),
+                   BinomialTree::price(american, numSteps));
+  ASSERT_DOUBLE_EQ(BinomialTree::price(empty, numSteps),
+                   BinomialTree::price(european, numSteps));
+}
+
+TEST(BinomialTreeTest, InvalidNumSteps) {
+  const AmericanOption option(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  ASSERT_THROW(BinomialTree::price(option, 0), std::invalid_argument);
+}
+
+template <typename Real> void checkBatchMatchesScalar() {
+  // not a multiple of the lane count, calls and puts interleaved
+  std::vector<BasicAmericanOption<Real>> book;
+  for (int i = 0; i < 2 * BinomialTree::kBatchLanes<Real> + 3; ++i) {
+    book.emplace_back(Real(90 + i), Real(100), Real(0.01 * (i % 6)),
+                      Real(0.25 + 0.1 * (i % 5)), Real(0.15 + 0.02 * (i % 7)),
+                      i % 3 == 0 ? OptionType::Call : OptionType::Put,
+                      Real(0.01 * (i % 4)));
+  }
+  std::vector<Real> prices(book.size());
+  BinomialTree::priceBatch(book, 150, prices.data(), 2);
+  for (size_t i = 0; i < book.size(); ++i) {
+    ASSERT_EQ(prices[i], BinomialTree::price(book[i], 150));
+  }
+}
+
+TEST(BinomialTreeTest, BatchMatchesScalar) {
+  checkBatchMatchesScalar<float>();
+  checkBatchMatchesScalar<double>();
+  std::vector<double> prices(1);
+  ASSERT_THROW(BinomialTree::priceBatch(
+                   std::vector<AmericanOption>{
+                       {100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put}},
+                   0, prices.data()),
+               std::invalid_argument);
+}
+
+TEST(BinomialTreeTest, ParallelMatchesSerial) {
+  // tiles and blocks that do not divide the tree, several threads
+  const WavefrontConfig small{7, 5};
+  const AmericanOption american(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  const AmericanOptionF americanF(100, 100, 0.02f, 1, 0.3f, OptionType::Call,
+                                  0.06f);
+  const EuropeanOption european(100.0, 95.0, 0.05, 1.0, 0.2, OptionType::Call);
+  const BermudanOption bermudan(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put,
+                                {0.25, 0.5, 0.75});
+  ASSERT_EQ(BinomialTree::priceParallel(american, 1001, 4, small),
+            BinomialTree::price(american, 1001));
+  ASSERT_EQ(BinomialTree::priceParallel(americanF, 1001, 3, small),
+            BinomialTree::price(americanF, 1001));
+  ASSERT_EQ(BinomialTree::priceParallel(european, 1000, 4, small),
+            BinomialTree::price(european, 1000));
+  ASSERT_EQ(BinomialTree::priceParallel(bermudan, 999, 2, small),
+            BinomialTree::price(bermudan, 999));
+  ASSERT_EQ(BinomialTree::priceParallel(american, 20000, 4),
+            BinomialTree::price(american, 20000));
+  ASSERT_THROW(BinomialTree::priceParallel(american, 100, 2, {0, 8}),
+               std::invalid_argument);
+  ASSERT_THROW(BinomialTree::priceParallel(american, 0), std::invalid_argument);
+}
+
+TEST(NumaBookTest, MatchesFlatBatch) {
+  // two nodes sharing CPU 0, so the layout is exercised on any machine
+  const NumaTopology topology{{{0, {0}}, {1, {0}}}};
+  std::vector<EuropeanOption> european;
+  std::vector<AmericanOption> american;
+  for (int i = 0; i < 37; ++i) {
+    european.emplace_back(100.0, 80.0 + i, 0.03, 0.5, 0.2,
+                          i % 2 ? OptionType::Put : OptionType::Call);
+    american.emplace_back(100.0, 80.0 + i, 0.03, 0.5, 0.2,
+                          i % 2 ? OptionType::Put : OptionType::Call, 0.02);
+  }
+
+  NumaBook<EuropeanOption> europeanBook(european, topology, 3);
+  europeanBook.run([](const size_t, const std::vector<EuropeanOption> &options,
+                      double *prices) {
+    BlackScholes::priceBatch(options, prices);
+  });
+  std::vector<double> prices(european.size());
+  std::vector<double> expected(european.size());
+  europeanBook.gather(prices.data());
+  BlackScholes::priceBatch(european, expected.data());
+  ASSERT_EQ(prices, expected);
+
+  NumaBook<AmericanOption> americanBook(american, topology);
+  americanBook.run([](const size_t, const std::vector<AmericanOption> &options,
+                      double *out) {
+    BinomialTree::priceBatch(options, 100, out);
+  });
+  americanBook.gather(prices.data());
+  for (size_t i = 0; i < american.size(); ++i) {
+    ASSERT_EQ(prices[i], BinomialTree::price(american[i], 100));
+  }
+  ASSERT_THROW(NumaBook<EuropeanOption>(european, NumaTopology{{{0, {}}}}),
+               std::invalid_argument);
+}
+
+TEST(TermStructureTest, FlatCurveMatchesFlatRate) {
+  const YieldCurve curve = YieldCurve::flat(0.05);
+  const EuropeanOption european(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call);
+  const AmericanOption american(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  ASSERT_NEAR(BlackScholes::price(european, curve),
+              BlackScholes::price(european), 1e-12);
+  ASSERT_NEAR(BinomialTree::price(american, 500, curve),
+              BinomialTree::price(american, 500), 1e-10);
+}
+
+TEST(TermStructureTest, EscrowedDividendBlackScholes) {
+  const YieldCurve curve({0.5, 1.0}, {0.03, 0.04});
+  const DividendSchedule dividends({{0.25, 1.0}, {0.75, 1.0}});
+  const EuropeanOption option(100.0, 100.0, 0.0, 1.0, 0.2, OptionType::Call);
+  const double pv = dividends.presentValue(curve, 0.0, 1.0);
+  const EuropeanOption escrowed(100.0 - pv, 100.0, curve.zeroRate(1.0), 1.0,
+                                0.2, OptionType::Call);
+  ASSERT_NEAR(BlackScholes::price(option, curve, dividends),
+              BlackScholes::price(escrowed), 1e-12);
+  ASSERT_LT(BlackScholes::price(option, curve, dividends),
+            BlackScholes::price(option, curve));
+}
+
+TEST(TermStructureTest, TreeMatchesBlackScholesWithDividends) {
+  const YieldCurve curve({0.5, 1.0}, {0.03, 0.04});
+  const DividendSchedule dividends({{0.25, 1.0}, {0.75, 1.0}});
+  const EuropeanOption put(100.0, 100.0, 0.0, 1.0, 0.2, OptionType::Put);
+  ASSERT_NEAR(BinomialTree::price(put, 2000, curve, dividends),
+              BlackScholes::price(put, curve, dividends), 1e-2);
+
+  // early exercise just before the dividends makes the American call worth
+  // more than its European counterpart
+  const AmericanOption americanCall(100.0, 95.0, 0.0, 1.0, 0.2,
+                                    OptionType::Call);
+  const EuropeanOption europeanCall(100.0, 95.0, 0.0, 1.0, 0.2,
+                                    OptionType::Call);
+  const DividendSchedule large({{0.5, 8.0}});
+  ASSERT_GT(BinomialTree::price(americanCall, 1000, curve, large),
+            BinomialTree::price(europeanCall, 1000, curve, large) + 1e-3);
+}
+
+TEST(TermStructureTest, GreeksOnCurveWithDividends) {
+  const YieldCurve curve({0.5, 1.0}, {0.03, 0.04});
+  const DividendSchedule dividends({{0.25, 1.0}, {0.75, 1.0}});
+  const EuropeanOption option(100.0, 100.0, 0.0, 1.0, 0.2, OptionType::Put);
+  const EuropeanOption escrowed(100.0 - dividends.presentValue(curve, 0.0, 1.0),
+                                100.0, curve.zeroRate(1.0), 1.0, 0.2,
+                                OptionType::Put);
+  ASSERT_NEAR(BlackScholes::gamma(option, curve, dividends),
+              BlackScholes::gamma(escrowed), 1e-12);
+  ASSERT_NEAR(BlackScholes::vega(option, curve, dividends),
+              BlackScholes::vega(escrowed), 1e-12);
+  ASSERT_NEAR(BlackScholes::theta(option, curve, dividends),
+              BlackScholes::theta(escrowed), 1e-12);
+  ASSERT_NEAR(BlackScholes::rho(option, curve, dividends),
+              BlackScholes::rho(escrowed), 1e-12);
+
+  // the tree Greeks see the dividends too
+  ASSERT_NEAR(BinomialTree::delta(option, 1000, curve, dividends),
+              BlackScholes::delta(option, curve, dividends), 5e-3);
+  ASSERT_NEAR(BinomialTree::gamma(option, 1000, curve, dividends),
+              BlackScholes::gamma(option, curve, dividends), 5e-3);
+  const AmericanOption american(100.0, 100.0, 0.0, 1.0, 0.2, OptionType::Put);
+  ASSERT_LT(BinomialTree::delta(american, 500, curve, dividends),
+            BinomialTree::delta(american, 500, curve));
+  ASSERT_NE(BinomialTree::theta(american, 500, curve, dividends),
+            BinomialTree::theta(american, 500, curve));
+}
+
+TEST(PrecisionTest, SinglePrecisionBlackScholesAccuracy) {
+  std::vector<EuropeanOption> book;
+  for (double strike = 60.0; strike <= 140.0; strike += 5.0) {
+    for (double sigma = 0.1; sigma <= 0.6; sigma += 0.1) {
+      book.emplace_back(100.0, strike, 0.03, 0.75, sigma, OptionType::Call,
+                        0.01);
+      book.emplace_back(100.0, strike, 0.03, 0.75, sigma, OptionType::Put,
+                        0.01);
+    }
+  }
+  std::vector<EuropeanOptionF> singles;
+  for (const EuropeanOption &option : book) {
+    singles.push_back(MixedPrecision::toSingle(option));
+  }
+  std::vector<float> batch(book.size());
+  BlackScholes::priceBatch(singles, batch.data());
+
+  double maxError = 0.0;
+  for (size_t i = 0; i < book.size(); ++i) {
+    const double reference = BlackScholes::price(book[i]);
+    maxError = std::max(maxError, std::abs(BlackScholes::price(singles[i]) -
+                                           reference));
+    maxError = std::max(maxError, std::abs(batch[i] - reference));
+  }
+  ASSERT_LT(maxError, 1e-4);
+}
+
+TEST(PrecisionTest, SinglePrecisionBinomialTreeAccuracy) {
+  const AmericanOption option(100.0, 105.0, 0.05, 1.0, 0.25, OptionType::Put);
+  const AmericanOptionF single = MixedPrecision::toSingle(option);
+  ASSERT_NEAR(BinomialTree::price(single, 1000),
+              BinomialTree::price(option, 1000), 1e-3);
+}
+
+TEST(PrecisionTest, MixedPrecisionScreening) {
+  std::vector<EuropeanOption> book;
+  for (double strike = 80.0; strike <= 120.0; strike += 10.0) {
+    book.emplace_back(100.0, strike, 0.05, 1.0, 0.2, OptionType::Call);
+  }
+  const ScreeningResult result = MixedPrecision::screen(
+      book, [](const size_t &, const float &price) { return price > 10.0f; });
+  ASSERT_EQ(result.prices.size(), book.size());
+  ASSERT_EQ(result.flagged, (std::vector<size_t>{0, 1, 2}));
+  for (const size_t &i : result.flagged) {
+    ASSERT_EQ(result.prices[i], BlackScholes::price(book[i]));
+  }
+  ASSERT_NEAR(result.prices[4], BlackScholes::price(book[4]), 1e-4);
+}
+
+TEST(PrecisionTest, MixedPrecisionAmericanScreening) {
+  std::vector<AmericanOption> book;
+  for (int i = 0; i < 20; ++i) {
+    book.emplace_back(100.0, 80.0 + 2.0 * i, 0.05, 1.0, 0.2,
+                      i % 2 ? OptionType::Put : OptionType::Call, 0.01);
+  }
+  const ScreeningResult result = MixedPrecision::screen(
+      book, 200,
+      [](const size_t &, const float &price) { return price > 8.0f; });
+  ASSERT_EQ(result.prices.size(), book.size());
+  ASSERT_FALSE(result.flagged.empty());
+  size_t next = 0;
+  for (size_t i = 0; i < book.size(); ++i) {
+    const double exact = BinomialTree::price(book[i], 200);
+    if (next < result.flagged.size() && result.flagged[next] == i) {
+      ++next;
+      ASSERT_EQ(result.prices[i], exact);
+    } else {
+      ASSERT_LE(result.prices[i], 8.0);
+      ASSERT_NEAR(result.prices[i], exact, 1e-3);
+    }
+  }
+  ASSERT_EQ(next, result.flagged.size());
+}
+
+TEST(ScenarioEngineTest, EuropeanCubeMatchesRepricing) {
+  std::vector<EuropeanOption> book;
+  for (int i = 0; i < 40; ++i) {
+    book.emplace_back(100.0, 80.0 + i, 0.03, 0.5 + 0.05 * i, 0.25,
+                      i % 2 == 0 ? OptionType::Call : OptionType::Put, 0.01);
+  }
+  const ShockGrid grid{{-0.1, 0.0, 0.1}, {-0.05, 0.0, 0.05}, {0.0, 0.01}};
+  const PnlCube cube = ScenarioEngine::run(book, grid, 3);
+  ASSERT_EQ(cube.values().size(), book.size() * 3 * 3 * 2);
+
+  for (size_t c = 0; c < book.size(); ++c) {
+    const EuropeanOption &option = book[c];
+    const double base = BlackScholes::price(option);
+    for (size_t s = 0; s < 3; ++s) {
+      for (size_t v = 0; v < 3; ++v) {
+        for (size_t r = 0; r < 2; ++r) {
+          const EuropeanOption shocked(
+              option.getSpotPrice() * (1.0 + grid.spotShocks[s]),
+              option.getStrikePrice(),
+              option.getRiskFreeRate() + grid.rateShocks[r],
+              option.getMaturity(),
+              option.getVolatility() + grid.volShocks[v], option.getType(),
+              option.getDividendYield());
+          // the normal cdf approximation jumps by ~1e-7 at zero, which an
+          // at-the-money d2 can land on from either side
+          ASSERT_NEAR(cube(c, s, v, r), BlackScholes::price(shocked) - base,
+                      1e-6);
+        }
+      }
+    }
+    ASSERT_NEAR(cube(c, 1, 1, 0), 0.0, 1e-10);
+  }
+}
+
+TEST(ScenarioEngineTest, ThreadCountDoesNotChangeResult) {
+  std::vector<EuropeanOption> european;
+  std::vector<AmericanOption> american;
+  for (int i = 0; i < 5; ++i) {
+    european.emplace_back(100.0, 90.0 + 5 * i, 0.05, 1.0, 0.2,
+                          OptionType::Put);
+    american.emplace_back(100.0, 90.0 + 5 * i, 0.05, 1.0, 0.2,
+                          OptionType::Put);
+  }
+  const ShockGrid grid{{-0.05, 0.05}, {0.0, 0.02}, {0.0, 0.01}};
+  ASSERT_EQ(ScenarioEngine::run(european, grid, 1).values(),
+            ScenarioEngine::run(european, grid, 4).values());
+  const PnlCube serial = ScenarioEngine::run(american, grid, 100, 1);
+  ASSERT_EQ(serial.values(),
+            ScenarioEngine::run(american, grid, 100, 4).values());
+
+  // the lane-batched lattice reproduces per-scenario repricing exactly
+  for (size_t c = 0; c < american.size(); ++c) {
+    const double base = BinomialTree::price(american[c], 100);
+    for (size_t s = 0; s < 2; ++s) {
+      for (size_t v = 0; v < 2; ++v) {
+        for (size_t r = 0; r < 2; ++r) {
+          const AmericanOption shocked(
+              100.0 * (1.0 + grid.spotShocks[s]), 90.0 + 5 * c,
+              0.05 + grid.rateShocks[r], 1.0, 0.2 + grid.volShocks[v],
+              OptionType::Put);
+          ASSERT_EQ(serial(c, s, v, r),
+                    BinomialTree::price(shocked, 100) - base);
+        }
+      }
+    }
+  }
+}
+
+TEST(ScenarioEngineTest, InvalidGrid) {
+  const std::vector<EuropeanOption> book{
+      {100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call}};
+  ASSERT_THROW(ScenarioEngine::run(book, {{}, {0.0}, {0.0}}),
+               std::invalid_argument);
+  ASSERT_THROW(ScenarioEngine::run(book, {{-1.0}, {0.0}, {0.0}}),
+               std::invalid_argument);
+  ASSERT_THROW(ScenarioEngine::run(book, {{0.0}, {-0.3}, {0.0}}),
+               std::invalid_argument);
+}
+
+TEST(ScenarioEngineTest, InvalidAmericanContract) {
+  std::vector<AmericanOption> book{
+      {100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put},
+      {100.0, 110.0, 0.05, 1.0, 0.2, OptionType::Put}};
+  // every shocked volatility is positive, so only the contract check fires
+  const ShockGrid grid{{-0.1, 0.0, 0.1}, {0.5}, {0.0}};
+  ASSERT_NO_THROW(ScenarioEngine::run(book, grid, 50));
+  book[1].setVolatility(-0.2);
+  ASSERT_THROW(ScenarioEngine::run(book, grid, 50), std::invalid_argument);
+  book[1].setVolatility(0.2);
+  book[0].setMaturity(0.0);
+  ASSERT_THROW(ScenarioEngine::run(book, grid, 50), std::invalid_argument);
+}
+
+// reference prices from a 5000-step tree
+std::vector<AmericanOption> analyticAmericanBook() {
+  return {{100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put},
+          {90.0, 100.0, 0.08, 0.5, 0.3, OptionType::Put, 0.02},
+          {110.0, 100.0, 0.05, 2.0, 0.25, OptionType::Put, 0.08},
+          {100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call, 0.04},
+          {120.0, 100.0, 0.03, 3.0, 0.35, OptionType::Call, 0.07},
+          {100.0, 100.0, 0.0, 1.0, 0.2, OptionType::Call, 0.03}};
+}
+
+TEST(AnalyticAmericanTest, MatchesTree) {
+  for (const AmericanOption &option : analyticAmericanBook()) {
+    const double tree = BinomialTree::price(option, 5000);
+    ASSERT_NEAR(AnalyticAmerican::baroneAdesiWhaley(option), tree, 0.15);
+    ASSERT_NEAR(AnalyticAmerican::bjerksundStensland(option), tree, 0.11);
+    ASSERT_NEAR(AnalyticAmerican::exerciseBoundary(option), tree, 1e-3);
+  }
+}
+
+TEST(AnalyticAmericanTest, IterationsRefineBoundary) {
+  const AmericanOption option(90.0, 100.0, 0.08, 0.5, 0.3, OptionType::Put,
+                              0.02);
+  const double tree = BinomialTree::price(option, 5000);
+  ExerciseBoundaryConfig config;
+  config.iterations = 0; // the Barone-Adesi-Whaley boundary
+  const double seeded = AnalyticAmerican::exerciseBoundary(option, config);
+  config.iterations = 6;
+  const double refined = AnalyticAmerican::exerciseBoundary(option, config);
+  ASSERT_LT(std::abs(refined - tree), std::abs(seeded - tree) / 10.0);
+}
+
+TEST(AnalyticAmericanTest, NoEarlyExercise) {
+  // calls without dividends are worth their European counterpart, up to
+  // the error of the Black-Scholes engine's cdf approximation
+  const AmericanOption call(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call);
+  const EuropeanOption european(100.0, 100.0, 0.05, 1.0, 0.2,
+                                OptionType::Call);
+  for (const AmericanApproximation method :
+       {AmericanApproximation::BaroneAdesiWhaley,
+        AmericanApproximation::BjerksundStensland,
+        AmericanApproximation::ExerciseBoundary}) {
+    ASSERT_NEAR(AnalyticAmerican::price(call, method),
+                BlackScholes::price(european), 1e-5);
+  }
+  // deep in the money puts are exercised
+  const AmericanOption put(50.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  ASSERT_DOUBLE_EQ(AnalyticAmerican::exerciseBoundary(put), 50.0);
+  ASSERT_DOUBLE_EQ(AnalyticAmerican::baroneAdesiWhaley(put), 50.0);
+}
+
+TEST(AnalyticAmericanTest, BatchMatchesSingle) {
+  const std::vector<AmericanOption> book = analyticAmericanBook();
+  std::vector<double> prices(book.size());
+  AnalyticAmerican::priceBatch(book, prices.data(),
+                               AmericanApproximation::ExerciseBoundary, {}, 4);
+  for (size_t i = 0; i < book.size(); ++i) {
+    ASSERT_EQ(prices[i], AnalyticAmerican::exerciseBoundary(book[i]));
+  }
+}
+
+TEST(AnalyticAmericanTest, InvalidInput) {
+  const AmericanOption option(100.0, 100.0, 0.05, 1.0, -0.2, OptionType::Put);
+  ASSERT_THROW(AnalyticAmerican::baroneAdesiWhaley(option),
+               std::invalid_argument);
+  ExerciseBoundaryConfig config;
+  config.collocationNodes = 0;
+  ASSERT_THROW(AnalyticAmerican::exerciseBoundary(
+                   {100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put}, config),
+               std::invalid_argument);
+}
+
+ProxyConfig proxyConfig() {
+  ProxyConfig config;
+  config.box = {0.8, 1.2, 0.15, 0.35, 0.25, 1.0};
+  config.numSteps = 200;
+  return config;
+}
+
+TEST(ChebyshevProxyTest, MatchesTreeInsideBox) {
+  const ChebyshevProxy proxy =
+      ChebyshevProxy::build(proxyConfig(), {{0.05, 0.0, OptionType::Put},
+                                            {0.03, 0.05, OptionType::Call}});
+  for (size_t b = 0; b < proxy.buckets().size(); ++b) {
+    const ProxyBucket &bucket = proxy.buckets()[b];
+    const ProxyErrorEstimate estimate = proxy.errorEstimate(b);
+    double priceError = 0.0;
+    double deltaError = 0.0;
+    for (int s = 0; s < 50; ++s) {
+      // scattered off the nodes
+      const AmericanOption option(
+          80.0 + 40.0 * (s * 37 % 101) / 100.0, 100.0, bucket.riskFreeRate,
+          0.25 + 0.75 * (s * 71 % 89) / 88.0,
+          0.15 + 0.2 * (s * 53 % 97) / 96.0, bucket.type,
+          bucket.dividendYield);
+      ASSERT_TRUE(proxy.covers(option));
+      priceError =
+          std::max(priceError, std::abs(proxy.price(option) -
+                                        BinomialTree::price(option, 200)));
+      deltaError =
+          std::max(deltaError, std::abs(proxy.delta(option) -
+                                        BinomialTree::delta(option, 200)));
+    }
+    ASSERT_LT(priceError, 100.0 * estimate.price);
+    ASSERT_LT(priceError, 0.1);
+    ASSERT_LT(deltaError, estimate.delta);
+  }
+}
+
+TEST(ChebyshevProxyTest, FallsBackToTree) {
+  const ChebyshevProxy proxy =
+      ChebyshevProxy::build(proxyConfig(), {{0.05, 0.0, OptionType::Put}});
+  // outside the moneyness range, and in a bucket that was not tabulated
+  const AmericanOption deep(60.0, 100.0, 0.05, 0.5, 0.2, OptionType::Put);
+  const AmericanOption call(100.0, 100.0, 0.05, 0.5, 0.2, OptionType::Call);
+  for (const AmericanOption &option : {deep, call}) {
+    ASSERT_FALSE(proxy.covers(option));
+    ASSERT_EQ(proxy.price(option), BinomialTree::price(option, 200));
+    ASSERT_EQ(proxy.gamma(option), BinomialTree::gamma(option, 200));
+  }
+}
+
+TEST(ChebyshevProxyTest, ThreadCountDoesNotChangeTables) {
+  const ChebyshevProxy serial =
+      ChebyshevProxy::build(proxyConfig(), {{0.05, 0.0, OptionType::Put}}, 1);
+  const ChebyshevProxy parallel =
+      ChebyshevProxy::build(proxyConfig(), {{0.05, 0.0, OptionType::Put}}, 4);
+  const AmericanOption option(97.0, 100.0, 0.05, 0.4, 0.22, OptionType::Put);
+  ASSERT_EQ(serial.price(option), parallel.price(option));
+  ASSERT_EQ(serial.theta(option), parallel.theta(option));
+}
+
+TEST(ChebyshevProxyTest, SaveAndLoad) {
+  const ChebyshevProxy proxy =
+      ChebyshevProxy::build(proxyConfig(), {{0.05, 0.0, OptionType::Put}});
+  const std::string path = testing::TempDir() + "chebyshev_proxy.bin";
+  proxy.save(path);
+  const ChebyshevProxy loaded = ChebyshevProxy::load(path);
+  const AmericanOption option(103.0, 100.0, 0.05, 0.7, 0.3, OptionType::Put);
+  ASSERT_EQ(loaded.price(option), proxy.price(option));
+  ASSERT_EQ(loaded.gamma(option), proxy.gamma(option));
+  ASSERT_EQ(loaded.errorEstimate(0).price, proxy.errorEstimate(0).price);
+
+  // truncated
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+  }
+  ASSERT_THROW(ChebyshevProxy::load(path), std::runtime_error);
+  ASSERT_THROW(ChebyshevProxy::load(path + ".missing"), std::runtime_error);
+}
+
+TEST(ChebyshevProxyTest, InvalidConfig) {
+  ProxyConfig config = proxyConfig();
+  config.box.volMin = 0.5;
+  ASSERT_THROW(ChebyshevProxy::build(config, {}), std::invalid_argument);
+  config = proxyConfig();
+  config.maturityNodes = 0;
+  ASSERT_THROW(ChebyshevProxy::build(config, {}), std::invalid_argument);
+}
+
+TEST(HestonTest, BlackScholesLimit) {
+  // vanishing vol of vol with v0 = theta = sigma^2
+  const HestonParameters params{0.04, 1.0, 0.04, 1e-4, 0.0};
+  const EuropeanOption call(100.0, 110.0, 0.05, 1.0, 0.2, OptionType::Call,
+                            0.02);
+  const EuropeanOption put(100.0, 90.0, 0.05, 0.5, 0.2, OptionType::Put);
+  ASSERT_NEAR(Heston::price(call, params), BlackScholes::price(call), 1e-5);
+  ASSERT_NEAR(Heston::price(put, params), BlackScholes::price(put), 1e-5);
+}
+
+TEST(HestonTest, StripMethodsMatchIntegration) {
+  const HestonParameters params{0.04, 1.5, 0.05, 0.5, -0.7};
+  for (const double T : {0.1, 1.0, 5.0}) {
+    std::vector<EuropeanOption> strip;
+    for (int i = 0; i < 9; ++i) {
+      strip.emplace_back(100.0, 60.0 + 10.0 * i, 0.03, T, 0.2,
+                         i % 2 == 0 ? OptionType::Call : OptionType::Put,
+                         0.01);
+    }
+    std::vector<double> cos(strip.size());
+    std::vector<double> fft(strip.size());
+    Heston::priceStrip(strip, params, cos.data());
+    Heston::priceStrip(strip, params, fft.data(), StripMethod::CarrMadan);
+    for (size_t i = 0; i < strip.size(); ++i) {
+      const double reference = Heston::price(strip[i], params);
+      ASSERT_NEAR(cos[i], reference, 1e-5);
+      ASSERT_NEAR(fft[i], reference, 1e-5);
+    }
+  }
+}
+
+TEST(HestonTest, InvalidInput) {
+  const HestonParameters params{0.04, 1.5, 0.05, 0.5, -0.7};
+  const EuropeanOption option(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call);
+  ASSERT_THROW(Heston::price(option, {0.04, 1.5, 0.05, 0.5, -1.5}),
+               std::invalid_argument);
+  const EuropeanOption later(100.0, 100.0, 0.05, 2.0, 0.2, OptionType::Call);
+  std::vector<double> prices(2);
+  ASSERT_THROW(Heston::priceStrip({option, later}, params, prices.data()),
+               std::invalid_argument);
+  StripConfig config;
+  config.fftPoints = 1000;
+  ASSERT_THROW(Heston::priceStrip({option}, params, prices.data(),
+                                  StripMethod::CarrMadan, config),
+               std::invalid_argument);
+}
+
 TEST(ImpliedVolatilityTest, ImpliedVolatilityCalculation) {
   const EuropeanOption option(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call);
   constexpr double marketPrice = 10.45;
   const double &impliedVol =
       ImpliedVolatility::calculateImpliedVolatility(option, marketPrice);
   ASSERT_NEAR(impliedVol, 0.2, 1e-2);
+}
+
+TEST(ImpliedVolatilityTest, EuropeanBatchRoundTrip) {
+  std::vector<EuropeanOption> strip;
+  std::vector<double> quotes;
+  std::vector<double> vols;
+  for (int i = 0; i < 30; ++i) {
+    const double vol = 0.15 + 0.03 * (i % 11);
+    EuropeanOption option(100.0, 85.0 + i, 0.03, 0.5 + 0.25 * (i % 4),
+                          vol, i % 3 ? OptionType::Call : OptionType::Put,
+                          0.01);
+    quotes.push_back(BlackScholes::price(option));
+    vols.push_back(vol);
+    // cold and far-off warm starts alike
+    option.setVolatilityImpl(i % 2 ? 0.2 : 0.02);
+    strip.push_back(option);
+  }
+  // below intrinsic, above the upper bound, an invalid contract
+  strip.emplace_back(100.0, 50.0, 0.03, 1.0, 0.2, OptionType::Call);
+  quotes.push_back(40.0);
+  strip.emplace_back(100.0, 50.0, 0.03, 1.0, 0.2, OptionType::Call);
+  quotes.push_back(100.0);
+  strip.emplace_back(100.0, 50.0, 0.03, -1.0, 0.2, OptionType::Call);
+  quotes.push_back(55.0);
+
+  std::vector<double> solved(strip.size());
+  ImpliedVolatility::impliedVolatilityBatch(strip, quotes, solved.data());
+  for (size_t i = 0; i < vols.size(); ++i) {
+    ASSERT_NEAR(solved[i], vols[i], 1e-6);
+  }
+  for (size_t i = vols.size(); i < strip.size(); ++i) {
+    ASSERT_TRUE(std::isnan(solved[i]));
+  }
+  ASSERT_THROW(ImpliedVolatility::impliedVolatilityBatch(strip, {1.0},
+                                                         solved.data()),
+               std::invalid_argument);
+}
+
+TEST(BinomialTreeTest, PriceWithVegaMatchesBumpedTree) {
+  for (const OptionType type : {OptionType::Call, OptionType::Put}) {
+    const AmericanOption option(100.0, 105.0, 0.05, 1.0, 0.25, type, 0.03);
+    const LatticeSensitivity tree = BinomialTree::priceWithVega(option, 400);
+    AmericanOption up = option;
+    AmericanOption down = option;
+    up.setVolatility(0.25 + 1e-6);
+    down.setVolatility(0.25 - 1e-6);
+    ASSERT_EQ(tree.price, BinomialTree::price(option, 400));
+    const double bumped =
+        (BinomialTree::price(up, 400) - BinomialTree::price(down, 400)) / 2e-6;
+    ASSERT_NEAR(tree.vega, bumped, 1e-5);
+  }
+}
+
+TEST(ImpliedVolatilityTest, AmericanRoundTrip) {
+  std::vector<AmericanOption> chain;
+  std::vector<double> quotes;
+  std::vector<double> vols;
+  // strikes 70-125: deeper puts are quoted at intrinsic
+  for (int i = 0; i < 12; ++i) {
+    const double vol = 0.15 + 0.02 * (i % 9);
+    AmericanOption option(100.0, 70.0 + 5.0 * i, 0.04, 0.75, vol,
+                          i % 2 == 0 ? OptionType::Call : OptionType::Put,
+                          0.02);
+    quotes.push_back(BinomialTree::price(option, 500));
+    vols.push_back(vol);
+    option.setVolatility(0.3); // the solver starts from the option's vol
+    chain.push_back(option);
+  }
+  std::vector<AmericanImpliedVolResult> results(chain.size());
+  ImpliedVolatility::americanImpliedVolatilityBatch(chain, quotes,
+                                                    results.data(), {}, 2);
+  for (size_t i = 0; i < chain.size(); ++i) {
+    ASSERT_EQ(results[i].status, ImpliedVolStatus::Converged);
+    ASSERT_NEAR(results[i].volatility, vols[i], 1e-6);
+    ASSERT_LE(results[i].treeEvaluations, 12);
+  }
+}
+
+TEST(ImpliedVolatilityTest, AmericanQuoteStatus) {
+  const AmericanOption put(100.0, 150.0, 0.04, 0.75, 0.2, OptionType::Put);
+  const AmericanOption call(100.0, 90.0, 0.04, 0.75, 0.2, OptionType::Call);
+  ASSERT_EQ(ImpliedVolatility::americanImpliedVolatility(put, 50.0).status,
+            ImpliedVolStatus::BelowIntrinsic);
+  ASSERT_EQ(ImpliedVolatility::americanImpliedVolatility(call, 100.0).status,
+            ImpliedVolStatus::AboveUpperBound);
+  AmericanImpliedVolConfig budget;
+  budget.maxIterations = 1;
+  ASSERT_EQ(
+      ImpliedVolatility::americanImpliedVolatility(call, 15.0, budget).status,
+      ImpliedVolStatus::NotConverged);
+
+  AmericanImpliedVolConfig invalid;
+  invalid.maxVolatility = invalid.minVolatility;
+  ASSERT_THROW(
+      ImpliedVolatility::americanImpliedVolatility(call, 15.0, invalid),
+      std::invalid_argument);
+  std::vector<AmericanImpliedVolResult> results(1);
+  ASSERT_THROW(ImpliedVolatility::americanImpliedVolatilityBatch(
+                   {call}, {15.0, 16.0}, results.data()),
+               std::invalid_argument);
+}
+
+TEST(ImpliedVolatilityTest, AmericanInvalidQuotesDoNotAbortBatch) {
+  const AmericanOption call(100.0, 90.0, 0.04, 0.75, 0.2, OptionType::Call);
+  const double quote = BinomialTree::price(call, 500);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  ASSERT_EQ(ImpliedVolatility::americanImpliedVolatility(call, 0.0).status,
+            ImpliedVolStatus::InvalidInput);
+  ASSERT_EQ(ImpliedVolatility::americanImpliedVolatility(call, nan).status,
+            ImpliedVolStatus::InvalidInput);
+
+  const std::vector<AmericanOption> chain = {
+      call,
+      {-100.0, 90.0, 0.04, 0.75, 0.2, OptionType::Call},
+      {100.0, 90.0, 0.04, 0.0, 0.2, OptionType::Call},
+      {100.0, 90.0, 0.04, 0.75, nan, OptionType::Call},
+      call,
+      call};
+  const std::vector<double> quotes = {quote, quote, quote,
+                                      quote, -1.0,  quote};
+  std::vector<AmericanImpliedVolResult> results(chain.size());
+  ImpliedVolatility::americanImpliedVolatilityBatch(chain, quotes,
+                                                    results.data(), {}, 2);
+  for (const int &i : {0, 5}) {
+    ASSERT_EQ(results[i].status, ImpliedVolStatus::Converged);
+    ASSERT_NEAR(results[i].volatility, 0.2, 1e-6);
+  }
+  for (const int &i : {1, 2, 3, 4}) {
+    ASSERT_EQ(results[i].status, ImpliedVolStatus::InvalidInput);
+    ASSERT_EQ(results[i].treeEvaluations, 0);
+  }
 }
\ No newline at end of file
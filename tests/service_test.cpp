@@ -0,0 +1,615 @@
+#include "pricing/binomial_tree.h"
+#include "pricing/black_scholes.h"
+#include "pricing/implied_vol.h"
+#include "service/book_snapshot.h"
+#include "service/portfolio_risk.h"
+#include "service/pricing_service.h"
+#include "service/quote_pipeline.h"
+#include "service/risk_runner.h"
+#include "utils/bounded_queue.h"
+#include <cmath>
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <gtest/gtest.h>
+
+TEST(BoundedQueueTest, FifoAndCapacity) {
+  BoundedQueue<int> queue(3); // rounded up to 4
+  ASSERT_EQ(queue.capacity(), 4);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.tryPush(i));
+  }
+  int value = 42;
+  ASSERT_FALSE(queue.tryPush(value));
+  ASSERT_EQ(value, 42);
+  ASSERT_EQ(queue.sizeApprox(), 4);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.tryPop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(queue.tryPop(value));
+}
+
+TEST(BoundedQueueTest, MultipleProducers) {
+  BoundedQueue<int> queue(64);
+  constexpr int kPerProducer = 10000;
+  std::vector<std::thread> producers;
+  for (int p = 0; p < 3; ++p) {
+    producers.emplace_back([&queue] {
+      for (int i = 1; i <= kPerProducer; ++i) {
+        int value = i;
+        while (!queue.tryPush(value)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  long long sum = 0;
+  int value = 0;
+  for (int received = 0; received < 3 * kPerProducer;) {
+    if (queue.tryPop(value)) {
+      sum += value;
+      ++received;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (std::thread &producer : producers) {
+    producer.join();
+  }
+  ASSERT_EQ(sum, 3LL * kPerProducer * (kPerProducer + 1) / 2);
+}
+
+TEST(PricingServiceTest, FuturesMatchBlackScholes) {
+  PricingService service;
+  std::vector<EuropeanOption> options;
+  std::vector<std::future<double>> results;
+  for (int i = 0; i < 500; ++i) {
+    options.emplace_back(100.0, 80.0 + 0.1 * i, 0.05, 1.0, 0.2,
+                         i % 2 == 0 ? OptionType::Call : OptionType::Put);
+    results.push_back(service.submit(options.back()));
+  }
+  for (size_t i = 0; i < options.size(); ++i) {
+    ASSERT_DOUBLE_EQ(results[i].get(), BlackScholes::price(options[i]));
+  }
+  ASSERT_EQ(service.stats().requests, options.size());
+}
+
+TEST(PricingServiceTest, CoalescesIntoMicroBatches) {
+  PricingServiceConfig config;
+  config.maxBatchSize = 64;
+  config.maxBatchDelay = std::chrono::milliseconds(50);
+  std::atomic<int> completed{0};
+  PricingServiceStats stats{};
+  {
+    PricingService service(config);
+    for (int i = 0; i < 256; ++i) {
+      service.submit({100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call},
+                     [&completed](const double &price,
+                                  const std::exception_ptr &error) {
+                       if (!error && price > 0.0) {
+                         ++completed;
+                       }
+                     });
+    }
+    while (service.stats().requests < 256) {
+      std::this_thread::yield();
+    }
+    stats = service.stats();
+  }
+  ASSERT_EQ(completed.load(), 256);
+  ASSERT_EQ(stats.requests, 256u);
+  // a 50ms coalescing window turns 256 back-to-back submissions into far
+  // fewer dispatches than requests
+  ASSERT_GT(stats.batches, 0u);
+  ASSERT_LT(stats.batches, stats.requests);
+}
+
+TEST(PricingServiceTest, InvalidContractCompletesWithError) {
+  PricingService service;
+  std::future<double> invalid =
+      service.submit({100.0, 100.0, 0.05, 1.0, -0.2, OptionType::Call});
+  std::future<double> valid =
+      service.submit({100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Call});
+  ASSERT_THROW(invalid.get(), std::invalid_argument);
+  ASSERT_NEAR(valid.get(), 10.4506, 1e-4);
+}
+
+TEST(PricingServiceTest, MultipleProducers) {
+  PricingService service;
+  const EuropeanOption option(100.0, 100.0, 0.05, 1.0, 0.2, OptionType::Put);
+  const double expected = BlackScholes::price(option);
+  std::atomic<int> mismatches{0};
+  std::vector<std::thread> producers;
+  for (int p = 0; p < 4; ++p) {
+    producers.emplace_back([&] {
+      std::vector<std::future<double>> results;
+      for (int i = 0; i < 200; ++i) {
+        results.push_back(service.submit(option));
+      }
+      for (std::future<double> &result : results) {
+        if (result.get() != expected) {
+          ++mismatches;
+        }
+      }
+    });
+  }
+  for (std::thread &producer : producers) {
+    producer.join();
+  }
+  ASSERT_EQ(mismatches.load(), 0);
+  ASSERT_LE(service.stats().batches, service.stats().requests);
+}
+
+TEST(BookSnapshotTest, SaveAndRestore) {
+  const EuropeanOption european(100.0, 95.0, 0.03, 0.5, 0.2, OptionType::Call,
+                                0.01);
+  const AmericanOption american(100.0, 110.0, 0.04, 1.0, 0.25,
+                                OptionType::Put);
+  const double marketPrice = 9.0;
+  const double impliedVol =
+      ImpliedVolatility::calculateImpliedVolatility(european, marketPrice);
+  const std::string path = testing::TempDir() + "book_snapshot.bin";
+  const std::uint64_t inputs = BookSnapshot::fingerprint(
+      "market,100,0.03", BookSnapshot::fingerprint("book,v1"));
+  BookSnapshot::save(path,
+                     {BookSnapshot::record(european, impliedVol),
+                      BookSnapshot::record(american, std::nan(""))},
+                     inputs);
+
+  const BookSnapshot snapshot = BookSnapshot::open(path, inputs);
+  ASSERT_EQ(snapshot.size(), 2);
+  ASSERT_EQ(snapshot[0].strikePrice, 95.0);
+  // the saved implied vol becomes the contract's volatility
+  const EuropeanOption restored = snapshot.european(0);
+  ASSERT_EQ(restored.getVolatility(), impliedVol);
+  ASSERT_EQ(restored.getDividendYield(), 0.01);
+  ASSERT_NEAR(ImpliedVolatility::calculateImpliedVolatility(
+                  restored, marketPrice, 1e-9, 1000,
+                  restored.getVolatility()),
+              impliedVol, 1e-12);
+  const AmericanOption put = snapshot.american(1);
+  ASSERT_EQ(put.getVolatility(), 0.25);
+  ASSERT_EQ(put.getType(), OptionType::Put);
+  ASSERT_THROW(snapshot.american(0), std::invalid_argument);
+}
+
+TEST(BookSnapshotTest, RejectsStaleOrCorruptFiles) {
+  const std::string path = testing::TempDir() + "book_snapshot_corrupt.bin";
+  const EuropeanOption option(100.0, 100.0, 0.03, 1.0, 0.2, OptionType::Call);
+  const std::uint64_t inputs = BookSnapshot::fingerprint("book,v1");
+  BookSnapshot::save(path,
+                     {BookSnapshot::record(option, 0.21),
+                      BookSnapshot::record(option, 0.22)},
+                     inputs);
+  std::string bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in),
+                 std::istreambuf_iterator<char>());
+  }
+  const auto rewrite = [&](const std::string &contents) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  };
+
+  std::string flipped = bytes;
+  flipped[bytes.size() - 20] ^= 0x01; // a record byte: checksum mismatch
+  rewrite(flipped);
+  ASSERT_THROW(BookSnapshot::open(path, inputs), std::runtime_error);
+
+  std::string otherVersion = bytes;
+  otherVersion[4] += 1;
+  rewrite(otherVersion);
+  ASSERT_THROW(BookSnapshot::open(path, inputs), std::runtime_error);
+
+  rewrite(bytes.substr(0, bytes.size() - 8));
+  ASSERT_THROW(BookSnapshot::open(path, inputs), std::runtime_error);
+  ASSERT_THROW(BookSnapshot::open(path + ".missing", inputs),
+               std::runtime_error);
+
+  // intact, but the book it was taken from has changed since
+  rewrite(bytes);
+  ASSERT_THROW(BookSnapshot::open(path, BookSnapshot::fingerprint("book,v2")),
+               std::runtime_error);
+  ASSERT_EQ(BookSnapshot::open(path, inputs)[1].impliedVolatility, 0.22);
+}
+
+static std::vector<RiskPosition<EuropeanOption>> makeRiskBook() {
+  std::vector<RiskPosition<EuropeanOption>> book;
+  for (int i = 0; i < 40; ++i) {
+    book.push_back({static_cast<std::uint32_t>(i % 7), 1.0 + i % 3,
+                    EuropeanOption(100.0 + i % 7, 90.0 + i, 0.03, 0.5 + 0.1 * i,
+                                   0.2, i % 2 ? OptionType::Put
+                                              : OptionType::Call)});
+  }
+  return book;
+}
+
+TEST(RiskRunnerTest, MatchesInProcessGreeks) {
+  const std::vector<RiskPosition<EuropeanOption>> book = makeRiskBook();
+  RiskRunnerConfig config;
+  config.workers = 3;
+  const RiskReport report = RiskRunner::run(book, config);
+  ASSERT_EQ(report.reruns, 0);
+  ASSERT_EQ(report.underlyings.size(), 7);
+  double total = 0.0;
+  for (size_t i = 0; i < book.size(); ++i) {
+    const EuropeanOption &option = book[i].option;
+    ASSERT_EQ(report.positions[i].delta,
+              book[i].quantity * BlackScholes::delta(option));
+    ASSERT_EQ(report.positions[i].vega,
+              book[i].quantity * BlackScholes::vega(option));
+    total += book[i].quantity * BlackScholes::price(option);
+  }
+  double underlyingDelta = 0.0;
+  for (size_t i = 3; i < book.size(); i += 7) {
+    underlyingDelta += report.positions[i].delta;
+  }
+  ASSERT_EQ(report.underlyings[3], 3);
+  ASSERT_NEAR(report.byUnderlying[3].delta, underlyingDelta, 1e-12);
+  ASSERT_NEAR(report.total.price, total, 1e-9);
+}
+
+TEST(RiskRunnerTest, RerunsCrashedAndSlowShards) {
+  const std::vector<RiskPosition<EuropeanOption>> book = makeRiskBook();
+  RiskRunnerConfig config;
+  config.workers = 2;
+  const RiskReport clean = RiskRunner::run(book, config);
+
+  config.shardTimeout = std::chrono::milliseconds(200);
+  config.shardHook = [](const size_t shard, const int attempt) {
+    if (attempt == 0 && shard == 1) {
+      std::raise(SIGKILL);
+    }
+    if (attempt == 0 && shard == 4) {
+      std::this_thread::sleep_for(std::chrono::seconds(30));
+    }
+  };
+  const RiskReport recovered = RiskRunner::run(book, config);
+  ASSERT_EQ(recovered.reruns, 2);
+  for (size_t i = 0; i < book.size(); ++i) {
+    ASSERT_EQ(recovered.positions[i].price, clean.positions[i].price);
+  }
+  ASSERT_EQ(recovered.total.gamma, clean.total.gamma);
+
+  config.shardHook = [](const size_t shard, const int) {
+    if (shard == 0) {
+      std::raise(SIGKILL);
+    }
+  };
+  ASSERT_THROW(RiskRunner::run(book, config), std::runtime_error);
+  config.workers = 0;
+  ASSERT_THROW(RiskRunner::run(book, config), std::invalid_argument);
+}
+
+TEST(RiskRunnerTest, PricingErrorsAreReportedNotRetried) {
+  std::vector<RiskPosition<EuropeanOption>> book = makeRiskBook();
+  const RiskReport clean = RiskRunner::run(book, {});
+  book[5].option.setVolatilityImpl(-0.2);
+  book[12].option.setVolatilityImpl(0.0);
+  RiskRunnerConfig config;
+  config.workers = 2;
+  const RiskReport report = RiskRunner::run(book, config);
+  ASSERT_EQ(report.reruns, 0);
+  ASSERT_EQ(report.failed, (std::vector<size_t>{5, 12}));
+  ASSERT_EQ(report.positions[5].price, 0.0);
+  ASSERT_EQ(report.positions[12].delta, 0.0);
+  ASSERT_EQ(report.positions[6].price, clean.positions[6].price);
+  ASSERT_NEAR(report.total.price,
+              clean.total.price - clean.positions[5].price -
+                  clean.positions[12].price,
+              1e-9);
+  ASSERT_TRUE(clean.failed.empty());
+}
+
+TEST(RiskRunnerTest, AmericanPositions) {
+  const AmericanOption option(100.0, 105.0, 0.04, 1.0, 0.25, OptionType::Put);
+  RiskRunnerConfig config;
+  config.workers = 2;
+  config.numSteps = 100;
+  const RiskReport report =
+      RiskRunner::run({{1, 2.0, option}, {2, -1.0, option}}, config);
+  ASSERT_EQ(report.positions[0].price, 2.0 * BinomialTree::price(option, 100));
+  ASSERT_EQ(report.positions[1].delta, -BinomialTree::delta(option, 100));
+  ASSERT_NEAR(report.total.price, BinomialTree::price(option, 100), 1e-12);
+}
+
+TEST(RiskRunnerTest, AmericanPricingErrorsAreReported) {
+  std::vector<RiskPosition<AmericanOption>> book;
+  for (int i = 0; i < 8; ++i) {
+    book.push_back({static_cast<std::uint32_t>(i % 3), 1.0,
+                    AmericanOption(100.0, 90.0 + 3.0 * i, 0.04, 1.0, 0.25,
+                                   OptionType::Put)});
+  }
+  RiskRunnerConfig config;
+  config.workers = 2;
+  config.numSteps = 50;
+  const RiskReport clean = RiskRunner::run(book, config);
+  book[2].option.setVolatility(-0.2);
+  book[6].option.setVolatility(0.0);
+  const RiskReport report = RiskRunner::run(book, config);
+  ASSERT_EQ(report.reruns, 0);
+  ASSERT_EQ(report.failed, (std::vector<size_t>{2, 6}));
+  ASSERT_EQ(report.positions[2].price, 0.0);
+  ASSERT_EQ(report.positions[6].vega, 0.0);
+  ASSERT_TRUE(std::isfinite(report.total.price));
+  ASSERT_NEAR(report.total.price,
+              clean.total.price - clean.positions[2].price -
+                  clean.positions[6].price,
+              1e-9);
+  ASSERT_THROW(RiskRunner::measure(book[2].option, 50), std::invalid_argument);
+}
+
+static double pipelineSmile(const double &spot, const double &strike,
+                            const double &maturity,
+                            const double &dividendYield = 0.0) {
+  const double k = std::log(
+      strike / (spot * std::exp((0.03 - dividendYield) * maturity)));
+  return 0.22 - 0.08 * k + 0.25 * k * k;
+}
+
+// out-of-the-money quotes priced off pipelineSmile, in DataParser's format;
+// the header carries the dividend yield only when it is not zero
+static std::string makeQuoteSnapshot(const std::uint32_t &underlying,
+                                     const double &spot,
+                                     const double &dividendYield = 0.0) {
+  std::ostringstream text;
+  text << std::setprecision(17) << underlying << ',' << spot << ",0.03";
+  if (dividendYield != 0.0) {
+    text << ',' << dividendYield;
+  }
+  text << '\n';
+  for (const double maturity : {0.25, 0.5, 1.0, 2.0}) {
+    for (double strike = 70.0; strike <= 140.0; strike += 5.0) {
+      const OptionType type =
+          strike >= spot ? OptionType::Call : OptionType::Put;
+      const EuropeanOption option(
+          spot, strike, 0.03, maturity,
+          pipelineSmile(spot, strike, maturity, dividendYield), type,
+          dividendYield);
+      text << (type == OptionType::Call ? 'C' : 'P') << ',' << strike << ','
+           << maturity << ',' << BlackScholes::price(option) << '\n';
+    }
+  }
+  return text.str();
+}
+
+TEST(QuotePipelineTest, MatchesSerialRun) {
+  const std::vector<RiskPosition<EuropeanOption>> book = makeRiskBook();
+  std::vector<std::string> snapshots;
+  for (int round = 0; round < 2; ++round) {
+    for (std::uint32_t underlying = 0; underlying < 7; ++underlying) {
+      snapshots.push_back(
+          makeQuoteSnapshot(underlying, 100.0 + underlying + round));
+    }
+  }
+
+  QuotePipelineConfig config;
+  config.queueCapacity = 2;
+  config.threads = {1, 2, 1, 2};
+  std::mutex mutex;
+  std::vector<QuotePipelineResult> results;
+  QuotePipeline pipeline(
+      book,
+      [&](const QuotePipelineResult &result, const std::exception_ptr &error) {
+        ASSERT_FALSE(error);
+        const std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(result);
+      },
+      config);
+  for (const std::string &snapshot : snapshots) {
+    pipeline.submit(snapshot);
+  }
+  pipeline.drain();
+
+  const std::vector<QuotePipelineResult> serial =
+      QuotePipeline::runSerial(book, snapshots, config);
+  ASSERT_EQ(results.size(), snapshots.size());
+  std::sort(results.begin(), results.end(), [](const auto &l, const auto &r) {
+    return l.sequence < r.sequence;
+  });
+  for (size_t i = 0; i < results.size(); ++i) {
+    const QuotePipelineResult &result = results[i];
+    ASSERT_EQ(result.underlying, serial[i].underlying);
+    ASSERT_EQ(result.rejectedQuotes, 0);
+    ASSERT_EQ(result.positions, serial[i].positions);
+    ASSERT_NEAR(result.total.price, serial[i].total.price, 1e-6);
+    ASSERT_NEAR(result.total.vega, serial[i].total.vega, 1e-6);
+    const double spot = 100.0 + i % 7 + i / 7;
+    ASSERT_NEAR(result.surface->volatility(103.0, 0.75),
+                serial[i].surface->volatility(103.0, 0.75), 1e-8);
+    ASSERT_NEAR(result.surface->volatility(95.0, 0.5),
+                pipelineSmile(spot, 95.0, 0.5), 1e-7);
+  }
+
+  // the risk stage reprices the position with the surface vol
+  const QuotePipelineResult &first = serial[0];
+  const RiskPosition<EuropeanOption> &position = book[first.positions[1]];
+  const EuropeanOption &held = position.option;
+  const EuropeanOption repriced(
+      100.0, held.getStrikePrice(), 0.03, held.getMaturity(),
+      first.surface->volatility(held.getStrikePrice(), held.getMaturity()),
+      held.getType());
+  ASSERT_NEAR(first.risk[1].delta,
+              position.quantity * BlackScholes::delta(repriced), 1e-12);
+
+  const QuotePipelineStats stats = pipeline.stats();
+  ASSERT_EQ(stats.completed, snapshots.size());
+  for (const PipelineStageStats &stage : stats.stages) {
+    ASSERT_EQ(stage.snapshots, snapshots.size());
+    ASSERT_EQ(stage.queueDepth, 0);
+    ASSERT_LE(stage.peakQueueDepth, 2);
+  }
+  const auto risk = static_cast<size_t>(PipelineStage::Risk);
+  ASSERT_EQ(stats.stages[0].items, snapshots.size() * 4 * 15);
+  ASSERT_EQ(stats.stages[risk].items, 2 * book.size());
+}
+
+TEST(QuotePipelineTest, PositionsOnQuotedContractsRepriceToTheQuote) {
+  // the book's own spot, rate and dividend yield are stale; the snapshot's
+  // carry applies
+  const std::vector<RiskPosition<EuropeanOption>> book{
+      {4, 2.0, EuropeanOption(95.0, 90.0, 0.01, 0.5, 0.3, OptionType::Put)},
+      {4, -1.0, EuropeanOption(95.0, 110.0, 0.01, 1.0, 0.3, OptionType::Call,
+                               0.05)},
+      {4, 1.0, EuropeanOption(95.0, 125.0, 0.01, 2.0, 0.3, OptionType::Call)}};
+  const double spot = 102.0;
+  const double dividendYield = 0.025;
+  const QuotePipelineResult result = QuotePipeline::runSerial(
+      book, {makeQuoteSnapshot(4, spot, dividendYield)})[0];
+  ASSERT_EQ(result.rejectedQuotes, 0);
+  ASSERT_EQ(result.positions.size(), book.size());
+  for (size_t k = 0; k < book.size(); ++k) {
+    const EuropeanOption &held = book[k].option;
+    const EuropeanOption quoted(
+        spot, held.getStrikePrice(), 0.03, held.getMaturity(),
+        pipelineSmile(spot, held.getStrikePrice(), held.getMaturity(),
+                      dividendYield),
+        held.getType(), dividendYield);
+    ASSERT_NEAR(result.surface->volatility(held.getStrikePrice(),
+                                           held.getMaturity()),
+                quoted.getVolatility(), 1e-8);
+    ASSERT_NEAR(result.risk[k].price,
+                book[k].quantity * BlackScholes::price(quoted), 1e-7);
+  }
+}
+
+TEST(QuotePipelineTest, FailedSnapshotsCompleteWithError) {
+  std::mutex mutex;
+  std::vector<std::pair<size_t, std::exception_ptr>> completed;
+  {
+    QuotePipeline pipeline(makeRiskBook(),
+                           [&](const QuotePipelineResult &result,
+                               const std::exception_ptr &error) {
+                             const std::lock_guard<std::mutex> lock(mutex);
+                             completed.emplace_back(result.sequence, error);
+                           });
+    pipeline.submit("not a snapshot");
+    pipeline.submit("3,100,0.03\nC,50,1.0,0.5"); // below intrinsic
+    pipeline.submit(makeQuoteSnapshot(3, 100.0));
+  } // the destructor completes every accepted snapshot
+  ASSERT_EQ(completed.size(), 3);
+  std::sort(completed.begin(), completed.end(),
+            [](const auto &l, const auto &r) { return l.first < r.first; });
+  ASSERT_THROW(std::rethrow_exception(completed[0].second),
+               std::invalid_argument);
+  ASSERT_THROW(std::rethrow_exception(completed[1].second),
+               std::runtime_error);
+  ASSERT_FALSE(completed[2].second);
+
+  QuotePipelineConfig config;
+  config.threads[1] = 0;
+  ASSERT_THROW(QuotePipeline(makeRiskBook(), nullptr, config),
+               std::invalid_argument);
+}
+
+TEST(PortfolioAggregatorTest, BucketsMatchPerPositionGreeks) {
+  const std::vector<RiskPosition<EuropeanOption>> book = makeRiskBook();
+  const GreekBuckets buckets{{1.0, 2.5}, {0.9, 1.1}};
+  const PortfolioRisk risk = PortfolioAggregator::aggregate(book, buckets);
+  ASSERT_EQ(risk.underlyings.size(), 7);
+  ASSERT_EQ(risk.expiryBuckets, 3);
+  ASSERT_EQ(risk.moneynessBuckets, 3);
+  ASSERT_EQ(risk.cells.size(), 7 * 3 * 3);
+
+  std::vector<RiskMeasures> expected(risk.cells.size(), RiskMeasures{});
+  double total = 0.0;
+  for (const RiskPosition<EuropeanOption> &position : book) {
+    const EuropeanOption &option = position.option;
+    const size_t expiry = option.getMaturity() < 1.0   ? 0
+                          : option.getMaturity() < 2.5 ? 1
+                                                       : 2;
+    const double moneyness = option.getStrikePrice() / option.getSpotPrice();
+    const size_t strike = moneyness < 0.9 ? 0 : moneyness < 1.1 ? 1 : 2;
+    RiskMeasures &cell =
+        expected[(position.underlying * 3 + expiry) * 3 + strike];
+    cell.delta += position.quantity * BlackScholes::delta(option);
+    cell.vega += position.quantity * BlackScholes::vega(option);
+    total += position.quantity * BlackScholes::gamma(option);
+  }
+  for (size_t u = 0; u < 7; ++u) {
+    for (size_t e = 0; e < 3; ++e) {
+      for (size_t m = 0; m < 3; ++m) {
+        const size_t index = (u * 3 + e) * 3 + m;
+        ASSERT_NEAR(risk.cell(u, e, m).delta, expected[index].delta, 1e-12);
+        ASSERT_NEAR(risk.cell(u, e, m).vega, expected[index].vega, 1e-10);
+      }
+    }
+  }
+  ASSERT_NEAR(risk.total.gamma, total, 1e-12);
+
+  // a report by underlying alone agrees with the risk runner
+  RiskRunnerConfig config;
+  config.workers = 2;
+  const RiskReport report = RiskRunner::run(book, config);
+  const PortfolioRisk flat = PortfolioAggregator::aggregate(book, {});
+  ASSERT_EQ(flat.cells.size(), 7);
+  for (size_t u = 0; u < 7; ++u) {
+    ASSERT_NEAR(flat.byUnderlying[u].theta, report.byUnderlying[u].theta,
+                1e-10);
+  }
+}
+
+TEST(PortfolioAggregatorTest, ReproducibleAcrossThreadCounts) {
+  std::vector<RiskPosition<AmericanOption>> book;
+  for (int i = 0; i < 60; ++i) {
+    book.push_back({static_cast<std::uint32_t>(i % 3), 0.5 + i % 4,
+                    AmericanOption(100.0, 80.0 + i, 0.04, 0.25 + 0.05 * i,
+                                   0.25, i % 2 ? OptionType::Put
+                                               : OptionType::Call)});
+  }
+  const GreekBuckets buckets{{1.0}, {1.0}};
+  PortfolioRiskConfig config;
+  config.chunkSize = 7; // cells span chunks
+  config.numSteps = 50;
+  config.threads = 1;
+  const PortfolioRisk serial = PortfolioAggregator::aggregate(book, buckets,
+                                                              config);
+  for (const unsigned threads : {2u, 3u, 8u}) {
+    config.threads = threads;
+    const PortfolioRisk parallel =
+        PortfolioAggregator::aggregate(book, buckets, config);
+    for (size_t c = 0; c < serial.cells.size(); ++c) {
+      ASSERT_EQ(parallel.cells[c].price, serial.cells[c].price);
+      ASSERT_EQ(parallel.cells[c].gamma, serial.cells[c].gamma);
+      ASSERT_EQ(parallel.cells[c].rho, serial.cells[c].rho);
+    }
+    ASSERT_EQ(parallel.total.delta, serial.total.delta);
+    ASSERT_EQ(parallel.total.vega, serial.total.vega);
+  }
+
+  double price = 0.0;
+  for (const RiskPosition<AmericanOption> &position : book) {
+    price += position.quantity * BinomialTree::price(position.option, 50);
+  }
+  ASSERT_NEAR(serial.total.price, price, 1e-9);
+
+  ASSERT_THROW(PortfolioAggregator::aggregate(book, {{1.0, 1.0}, {}}),
+               std::invalid_argument);
+  config.chunkSize = 0;
+  ASSERT_THROW(PortfolioAggregator::aggregate(book, buckets, config),
+               std::invalid_argument);
+}
+
+TEST(PortfolioAggregatorTest, InvalidPositionsThrow) {
+  std::vector<RiskPosition<EuropeanOption>> european = makeRiskBook();
+  european[3].option.setVolatilityImpl(0.0);
+  ASSERT_THROW(PortfolioAggregator::aggregate(european, {}),
+               std::invalid_argument);
+
+  std::vector<RiskPosition<AmericanOption>> american;
+  for (int i = 0; i < 12; ++i) {
+    american.push_back({static_cast<std::uint32_t>(i % 2), 1.0,
+                        AmericanOption(100.0, 90.0 + 2.0 * i, 0.04, 1.0, 0.25,
+                                       OptionType::Put)});
+  }
+  PortfolioRiskConfig config;
+  config.numSteps = 50;
+  config.threads = 2;
+  ASSERT_NO_THROW(PortfolioAggregator::aggregate(american, {}, config));
+  american[7].option.setVolatility(-0.2);
+  ASSERT_THROW(PortfolioAggregator::aggregate(american, {}, config),
+               std::invalid_argument);
+}
\ No newline at end of file
@@ -1,5 +1,12 @@
 #include "error_messages.h"
+#include "utils/data_parser.h"
+#include "utils/numa.h"
 #include "utils/numerical_methods.h"
+#include "utils/parallel.h"
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 
 TEST(NumericalMethodsTest, NewtonRaphson) {
@@ -48,6 +55,201 @@ TEST(NumericalMethodsTest, NewtonRaphsonMaxIterations) {
                std::runtime_error);
 }
 
+TEST(NumericalMethodsTest, NormalDistribution) {
+  ASSERT_NEAR(NumericalMethods::normalCdf(0.0), 0.5, 1e-7);
+  ASSERT_NEAR(NumericalMethods::normalCdf(1.96), 0.9750021, 1e-7);
+  ASSERT_NEAR(NumericalMethods::normalCdf(-1.0), 0.1586553, 1e-7);
+  ASSERT_NEAR(NumericalMethods::normalPdf(0.0), 0.3989423, 1e-7);
+}
+
+TEST(NumericalMethodsTest, BivariateNormal) {
+  const double pi = std::acos(-1.0);
+  for (const double rho : {-0.99, -0.5, 0.0, 0.2, 0.8, 0.95}) {
+    // orthant probability
+    ASSERT_NEAR(NumericalMethods::bivariateNormalCdf(0.0, 0.0, rho),
+                0.25 + std::asin(rho) / (2.0 * pi), 1e-14);
+    // M(x, y, rho) + M(x, -y, -rho) = N(x)
+    ASSERT_NEAR(NumericalMethods::bivariateNormalCdf(0.3, -0.7, rho) +
+                    NumericalMethods::bivariateNormalCdf(0.3, 0.7, -rho),
+                0.5 * std::erfc(-0.3 / std::sqrt(2.0)), 1e-14);
+  }
+  ASSERT_NEAR(NumericalMethods::bivariateNormalCdf(1.0, -0.5, 0.0),
+              0.25 * std::erfc(-1.0 / std::sqrt(2.0)) *
+                  std::erfc(0.5 / std::sqrt(2.0)),
+              1e-15);
+}
+
+TEST(NumericalMethodsTest, GaussLegendre) {
+  // an n-point rule integrates polynomials of degree 2n - 1 exactly
+  const QuadratureRule rule = NumericalMethods::gaussLegendre(5);
+  double integral = 0.0;
+  for (size_t i = 0; i < rule.nodes.size(); ++i) {
+    const double x = rule.nodes[i];
+    integral += rule.weights[i] * (std::pow(x, 9) + 3.0 * std::pow(x, 8) + 1);
+  }
+  ASSERT_NEAR(integral, 2.0 * 3.0 / 9.0 + 2.0, 1e-14);
+  ASSERT_DOUBLE_EQ(rule.nodes[2], 0.0);
+}
+
+TEST(NumericalMethodsTest, FFT) {
+  std::vector<std::complex<double>> data;
+  for (int j = 0; j < 16; ++j) {
+    data.emplace_back(std::sin(0.3 * j), std::cos(0.7 * j * j));
+  }
+  std::vector<std::complex<double>> transformed = data;
+  NumericalMethods::fft(transformed);
+  const double pi = std::acos(-1.0);
+  for (int k = 0; k < 16; ++k) {
+    std::complex<double> expected = 0.0;
+    for (int j = 0; j < 16; ++j) {
+      expected += data[j] * std::polar(1.0, -2.0 * pi * j * k / 16.0);
+    }
+    ASSERT_NEAR(std::abs(transformed[k] - expected), 0.0, 1e-12);
+  }
+  std::vector<std::complex<double>> odd(12);
+  try {
+    NumericalMethods::fft(odd);
+    FAIL() << "expected std::invalid_argument";
+  } catch (const std::invalid_argument &error) {
+    ASSERT_STREQ(error.what(),
+                 ErrorMessages::NumericalMethods::kInvalidFftSize);
+  }
+}
+
+TEST(ParallelTest, ForEachVisitsEveryItemOnce) {
+  std::vector<std::atomic<int>> visits(1000);
+  Parallel::forEach(
+      visits.size(), [&](const size_t i) { ++visits[i]; }, 4);
+  for (const std::atomic<int> &count : visits) {
+    ASSERT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ParallelTest, ForEachRethrows) {
+  ASSERT_THROW(Parallel::forEach(
+                   100,
+                   [](const size_t i) {
+                     if (i == 42) {
+                       throw std::runtime_error("failed");
+                     }
+                   },
+                   4),
+               std::runtime_error);
+}
+
+TEST(ParallelTest, BarrierSeparatesPhases) {
+  // every thread must see all writes of a phase once it passes the barrier
+  constexpr size_t kThreads = 4;
+  constexpr int kPhases = 50;
+  Barrier barrier(kThreads);
+  std::vector<int> slots(kThreads, 0);
+  std::atomic<int> mismatches{0};
+  Parallel::forEach(
+      kThreads,
+      [&](const size_t t) {
+        for (int phase = 1; phase <= kPhases; ++phase) {
+          slots[t] = phase;
+          barrier.arriveAndWait();
+          for (const int &slot : slots) {
+            mismatches += slot != phase;
+          }
+          barrier.arriveAndWait();
+        }
+      },
+      kThreads);
+  ASSERT_EQ(mismatches.load(), 0);
+}
+
+TEST(NumaTest, ParseCpuList) {
+  ASSERT_EQ(Numa::parseCpuList("0-3,8,10-11"),
+            (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+  ASSERT_TRUE(Numa::parseCpuList("").empty());
+  ASSERT_THROW(Numa::parseCpuList("3-1"), std::invalid_argument);
+  ASSERT_THROW(Numa::parseCpuList("a"), std::invalid_argument);
+}
+
+TEST(NumaTest, DiscoverFromSysfs) {
+  // two nodes with CPUs and a memory-only one
+  const std::filesystem::path root =
+      std::filesystem::path(testing::TempDir()) / "numa_sysfs";
+  const std::vector<std::pair<std::string, std::string>> files = {
+      {"online", "0-2"},
+      {"node0/cpulist", "0-1"},
+      {"node1/cpulist", "2-3"},
+      {"node2/cpulist", ""}};
+  for (const auto &[name, contents] : files) {
+    std::filesystem::create_directories((root / name).parent_path());
+    std::ofstream(root / name) << contents << "\n";
+  }
+  const NumaTopology topology = Numa::discover(root.string());
+  ASSERT_EQ(topology.nodes.size(), 2);
+  ASSERT_EQ(topology.nodes[1].id, 1);
+  ASSERT_EQ(topology.nodes[1].cpus, (std::vector<int>{2, 3}));
+
+  const NumaTopology fallback = Numa::discover((root / "missing").string());
+  ASSERT_EQ(fallback.nodes.size(), 1);
+  ASSERT_EQ(fallback.nodes[0].cpus.size(), Parallel::defaultThreadCount());
+}
+
+TEST(NumaTest, ForEachWorkerVisitsEveryWorker) {
+  const NumaTopology topology{{{0, {0}}, {1, {0}}}};
+  std::atomic<int> visits[2][3] = {};
+  Numa::forEachWorker(
+      topology,
+      [&](const size_t node, const size_t worker, const size_t workers) {
+        ASSERT_EQ(workers, 3);
+        ++visits[node][worker];
+      },
+      3);
+  for (const auto &node : visits) {
+    for (const std::atomic<int> &count : node) {
+      ASSERT_EQ(count, 1);
+    }
+  }
+  ASSERT_THROW(Numa::forEachWorker({}, [](size_t, size_t, size_t) {}),
+               std::invalid_argument);
+}
+
+TEST(DataParserTest, ParsesSnapshot) {
+  const QuoteSnapshot snapshot =
+      DataParser::parseSnapshot("# underlying,spot,rate\n"
+                                "7,101.5,0.03\r\n"
+                                "C, 100, 0.5, 6.25\n"
+                                "\n"
+                                "P,95,1.0,3.5");
+  ASSERT_EQ(snapshot.underlying, 7);
+  ASSERT_EQ(snapshot.spot, 101.5);
+  ASSERT_EQ(snapshot.rate, 0.03);
+  ASSERT_EQ(snapshot.dividendYield, 0.0);
+  ASSERT_EQ(snapshot.quotes.size(), 2);
+  ASSERT_EQ(snapshot.quotes[0].type, OptionType::Call);
+  ASSERT_EQ(snapshot.quotes[0].strike, 100.0);
+  ASSERT_EQ(snapshot.quotes[0].price, 6.25);
+  ASSERT_EQ(snapshot.quotes[1].type, OptionType::Put);
+  ASSERT_EQ(snapshot.quotes[1].maturity, 1.0);
+
+  const QuoteSnapshot carried =
+      DataParser::parseSnapshot("7,101.5,0.03,0.015\nC,100,0.5,6.25");
+  ASSERT_EQ(carried.rate, 0.03);
+  ASSERT_EQ(carried.dividendYield, 0.015);
+  ASSERT_EQ(carried.quotes.size(), 1);
+}
+
+TEST(DataParserTest, RejectsMalformedInput) {
+  ASSERT_THROW(DataParser::parseSnapshot(""), std::invalid_argument);
+  ASSERT_THROW(DataParser::parseSnapshot("7,100"), std::invalid_argument);
+  ASSERT_THROW(DataParser::parseSnapshot("-1,100,0.03"),
+               std::invalid_argument);
+  ASSERT_THROW(DataParser::parseSnapshot("7,100,0.03,"), std::invalid_argument);
+  ASSERT_THROW(DataParser::parseSnapshot("7,100,0.03,0.01,2"),
+               std::invalid_argument);
+  ASSERT_THROW(DataParser::parseSnapshot("7,100,0.03\nX,100,0.5,6"),
+               std::invalid_argument);
+  ASSERT_THROW(DataParser::parseQuote("C,100,0.5"), std::invalid_argument);
+  ASSERT_THROW(DataParser::parseQuote("C,100,0.5,6,1"), std::invalid_argument);
+  ASSERT_THROW(DataParser::parseQuote("C,100,half,6"), std::invalid_argument);
+}
+
 TEST(ErrorMessagesTest, ErrorMessages) {
   ASSERT_EQ(ErrorMessages::BlackScholes::kInvalidSpotPrice,
             "Spot price must be positive.");